@@ -0,0 +1,31 @@
+// Copyright (c) Jared Taylor
+
+using UnrealBuildTool;
+
+public class PredictedMovementMass : ModuleRules
+{
+	public PredictedMovementMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"MassEntity",
+				"PredictedMovement",
+			}
+			);
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Engine",
+				"GameplayTags",
+				"MassCommon",
+				"MassMovement",
+			}
+			);
+	}
+}
@@ -0,0 +1,16 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierAgentFragments.h"
+
+#include "MassEntityManager.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierAgentFragments)
+
+
+FSharedStruct FModifierAgentConfigFragment::GetOrCreate(FMassEntityManager& EntityManager,
+	const TSharedRef<const FModifierAgentConfig>& Config)
+{
+	// Configs are remade whenever they are baked, so key by their tuning rather than their address
+	return EntityManager.GetOrCreateSharedFragmentByHash<FModifierAgentConfigFragment>(Config->GetTuningHash(), Config);
+}
@@ -0,0 +1,60 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierAgentProcessor.h"
+
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "MassMovementFragments.h"
+#include "Modifier/ModifierAgentFragments.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierAgentProcessor)
+
+
+UModifierAgentProcessor::UModifierAgentProcessor()
+	: EntityQuery(*this)
+{
+	bAutoRegisterWithProcessingPhases = true;
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+
+	// Modifiers scale the speed and gravity that movement reads
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Movement);
+}
+
+void UModifierAgentProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FModifierAgentFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddSharedRequirement<FModifierAgentConfigFragment>(EMassFragmentAccess::ReadOnly);
+}
+
+void UModifierAgentProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierAgentProcessor::Execute);
+
+	EntityQuery.ParallelForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& Context)
+	{
+		const FModifierAgentConfigFragment& ConfigFragment = Context.GetSharedFragment<FModifierAgentConfigFragment>();
+		if (!ConfigFragment.Config.IsValid())
+		{
+			return;
+		}
+
+		const FModifierAgentConfig& Config = *ConfigFragment.Config;
+		const TArrayView<FModifierAgentFragment> Agents = Context.GetMutableFragmentView<FModifierAgentFragment>();
+		const TConstArrayView<FMassVelocityFragment> Velocities = Context.GetFragmentView<FMassVelocityFragment>();
+
+		for (int32 Index = 0; Index < Context.GetNumEntities(); Index++)
+		{
+			FModifierAgentState& State = Agents[Index].State;
+
+			// Fragments are default constructed, so agents are sized to their config on first use
+			if (State.Levels.Num() != Config.NumChannels())
+			{
+				State.Init(Config);
+			}
+
+			State.Evaluate(Config, Velocities.Num() > 0 ? Velocities[Index].Value : FVector::ZeroVector);
+		}
+	});
+}
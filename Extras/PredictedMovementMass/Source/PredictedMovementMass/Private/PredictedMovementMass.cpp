@@ -0,0 +1,5 @@
+// Copyright (c) Jared Taylor
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, PredictedMovementMass)
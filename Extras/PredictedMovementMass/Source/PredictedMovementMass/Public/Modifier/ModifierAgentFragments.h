@@ -0,0 +1,49 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Modifier/ModifierAgent.h"
+#include "ModifierAgentFragments.generated.h"
+
+struct FMassEntityManager;
+
+/**
+ * Modifier state of a Mass agent, e.g. one entity of a crowd, see FModifierAgentState
+ * Add modifiers through State with the config of the entity's FModifierAgentConfigFragment, they apply the next time
+ * UModifierAgentProcessor runs
+ * Call State.Init() with the config before adding modifiers, the processor only does so for agents that have none
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENTMASS_API FModifierAgentFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FModifierAgentState State;
+};
+
+/**
+ * Modifier tuning shared by every agent with the same tuning, see FModifierAgentConfig
+ * Add it with GetOrCreate(), the config isn't a property so Mass can't hash it, GetOrCreate() keys it by its tuning
+ */
+USTRUCT()
+struct PREDICTEDMOVEMENTMASS_API FModifierAgentConfigFragment : public FMassSharedFragment
+{
+	GENERATED_BODY()
+
+	FModifierAgentConfigFragment() = default;
+
+	explicit FModifierAgentConfigFragment(const TSharedRef<const FModifierAgentConfig>& InConfig)
+		: Config(InConfig)
+	{}
+
+	TSharedPtr<const FModifierAgentConfig> Config;
+
+	/**
+	 * @return The shared fragment for the config's tuning, created once and shared by every agent with the same tuning
+	 * @see UModifierMovement::GetModifierAgentConfig()
+	 * @see FModifierAgentConfig::GetTuningHash()
+	 */
+	static FSharedStruct GetOrCreate(FMassEntityManager& EntityManager, const TSharedRef<const FModifierAgentConfig>& Config);
+};
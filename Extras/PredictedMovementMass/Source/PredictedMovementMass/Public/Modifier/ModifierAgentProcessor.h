@@ -0,0 +1,28 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityQuery.h"
+#include "MassProcessor.h"
+#include "ModifierAgentProcessor.generated.h"
+
+/**
+ * Evaluates the modifiers of every agent with a FModifierAgentFragment before Mass movement runs
+ * Chunks are evaluated in parallel, agents only read their shared config and write their own state
+ * Falling modifiers use FMassVelocityFragment if the agent has one
+ */
+UCLASS()
+class PREDICTEDMOVEMENTMASS_API UModifierAgentProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UModifierAgentProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,115 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierAgent.h"
+
+#include "Async/ParallelFor.h"
+
+
+TModSize FModifierAgentConfig::GetLevelIndex(int32 Channel, const FGameplayTag& Level) const
+{
+	const FModifierAgentChannel& Def = Channels[Channel];
+	const uint8* Index = Def.MovementTable.IsValid() ? Def.MovementTable->Indices.Find(Level) :
+		Def.FallingTable.IsValid() ? Def.FallingTable->Indices.Find(Level) : nullptr;
+	return Index ? *Index : NO_MODIFIER;
+}
+
+uint32 FModifierAgentConfig::GetTuningHash() const
+{
+	uint32 Hash = GetTypeHash(Channels.Num());
+	for (const FModifierAgentChannel& Channel : Channels)
+	{
+		Hash = HashCombineFast(Hash, GetTypeHash(Channel.ModifierType));
+		Hash = HashCombineFast(Hash, GetTypeHash(static_cast<uint8>(Channel.LevelMethod)));
+		Hash = HashCombineFast(Hash, GetTypeHash(Channel.MaxModifiers));
+		Hash = HashCombineFast(Hash, PointerHash(Channel.MovementTable.Get()));
+		Hash = HashCombineFast(Hash, PointerHash(Channel.FallingTable.Get()));
+	}
+	return Hash;
+}
+
+void FModifierAgentState::Init(const FModifierAgentConfig& Config)
+{
+	Modifiers.SetNum(Config.NumChannels());
+	Levels.Init(NO_MODIFIER, Config.NumChannels());
+	Params.Reset();
+	bDirty = true;
+}
+
+bool FModifierAgentState::AddModifier(const FModifierAgentConfig& Config, int32 Channel, TModSize Level)
+{
+	const int32 MaxModifiers = Config.Channels[Channel].MaxModifiers;
+	if (Level == NO_MODIFIER || (MaxModifiers > 0 && Modifiers[Channel].Num() >= MaxModifiers))
+	{
+		return false;
+	}
+
+	Modifiers[Channel].Add(Level);
+	bDirty = true;
+	return true;
+}
+
+bool FModifierAgentState::RemoveModifier(int32 Channel, TModSize Level, bool bRemoveAll)
+{
+	TModifierStack& Stack = Modifiers[Channel];
+	const int32 NumRemoved = bRemoveAll ? Stack.Remove(Level) : Stack.RemoveSingle(Level);
+	bDirty |= NumRemoved > 0;
+	return NumRemoved > 0;
+}
+
+void FModifierAgentState::ResetModifiers(int32 Channel)
+{
+	bDirty |= Modifiers[Channel].Num() > 0;
+	Modifiers[Channel].Reset();
+}
+
+bool FModifierAgentState::Evaluate(const FModifierAgentConfig& Config, const FVector& Velocity)
+{
+	if (!bDirty)
+	{
+		return false;
+	}
+	bDirty = false;
+
+	Params.Reset();
+	for (int32 Channel = 0; Channel < Config.NumChannels(); Channel++)
+	{
+		const FModifierAgentChannel& Def = Config.Channels[Channel];
+		const int32 NumLevels = Def.NumLevels();
+		const TModSize MaxLevel = NumLevels > 0 ? static_cast<TModSize>(NumLevels - 1) : 0;
+
+		const TModSize Level = FModifierStatics::UpdateModifierLevel(Def.LevelMethod, Modifiers[Channel], MaxLevel, NO_MODIFIER);
+		Levels[Channel] = Level;
+
+		// Combined in channel order, the same as FModifierRegistry::CombineEffectiveParams()
+		if (Def.MovementTable.IsValid() && Def.MovementTable->Params.IsValidIndex(Level))
+		{
+			Params.AddMovement(Def.MovementTable->Params[Level]);
+		}
+		if (Def.FallingTable.IsValid() && Def.FallingTable->Params.IsValidIndex(Level))
+		{
+			Params.AddFalling(Def.FallingTable->Params[Level], Velocity);
+		}
+	}
+	return true;
+}
+
+void FModifierAgentState::EvaluateAgents(const FModifierAgentConfig& Config, TArrayView<FModifierAgentState> Agents,
+	TArrayView<const FVector> Velocities, int32 ChunkSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierAgentState::EvaluateAgents);
+
+	check(Velocities.Num() == 0 || Velocities.Num() == Agents.Num());
+
+	// Agents only read the shared config and write their own state, so chunks need no synchronization
+	ChunkSize = FMath::Max(ChunkSize, 1);
+	const int32 NumChunks = FMath::DivideAndRoundUp(Agents.Num(), ChunkSize);
+	ParallelFor(NumChunks, [&](int32 Chunk)
+	{
+		const int32 Last = FMath::Min((Chunk + 1) * ChunkSize, Agents.Num());
+		for (int32 Index = Chunk * ChunkSize; Index < Last; Index++)
+		{
+			Agents[Index].Evaluate(Config, Velocities.Num() > 0 ? Velocities[Index] : FVector::ZeroVector);
+		}
+	});
+}
@@ -31,30 +31,60 @@ void AModifierCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& O
 	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, SimulatedSlowFall, SharedParams);
 }
 
-void AModifierCharacter::OnModifierChanged(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
-	const FGameplayTag& PrevModifierLevel)
+void AModifierCharacter::PostInitializeComponents()
 {
-	K2_OnModifierChanged(ModifierType, ModifierLevel, PrevModifierLevel);
+	Super::PostInitializeComponents();
+
+	BindSimulatedModifierLevels();
+}
+
+void AModifierCharacter::BindSimulatedModifierLevels()
+{
+	BindSimulatedModifierLevel(FModifierTags::Modifier_Boost, [](AModifierCharacter& Character, uint8 Level)
+	{
+		Character.SimulatedBoost = Level;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AModifierCharacter, SimulatedBoost, &Character);
+	});
+	BindSimulatedModifierLevel(FModifierTags::Modifier_Snare, [](AModifierCharacter& Character, uint8 Level)
+	{
+		Character.SimulatedSnare = Level;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AModifierCharacter, SimulatedSnare, &Character);
+	});
+	BindSimulatedModifierLevel(FModifierTags::Modifier_SlowFall, [](AModifierCharacter& Character, uint8 Level)
+	{
+		Character.SimulatedSlowFall = Level;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AModifierCharacter, SimulatedSlowFall, &Character);
+	});
+}
+
+void AModifierCharacter::BindSimulatedModifierLevel(const FGameplayTag& ModifierType, FSetSimulatedLevelFunc SetLevel)
+{
+	const int32 Channel = ModifierMovement ? ModifierMovement->GetModifierRegistry().FindChannel(ModifierType) : INDEX_NONE;
+	if (Channel != INDEX_NONE)
+	{
+		SimulatedLevelSetters.SetNumZeroed(ModifierMovement->GetModifierRegistry().NumChannels());
+		SimulatedLevelSetters[Channel] = SetLevel;
+	}
+}
 
+void AModifierCharacter::NotifyModifierChannelChanged(int32 Channel, const FGameplayTag& ModifierType,
+	const FGameplayTag& ModifierLevel, const FGameplayTag& PrevModifierLevel, uint8 ModifierLevelValue,
+	uint8 PrevModifierLevelValue)
+{
 	// Replicate to simulated proxies
-	if (ModifierMovement && HasAuthority())
+	if (HasAuthority() && SimulatedLevelSetters.IsValidIndex(Channel) && SimulatedLevelSetters[Channel])
 	{
-		if (ModifierType == FModifierTags::Modifier_Boost)
-		{
-			SimulatedBoost = ModifierMovement->GetBoostLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedBoost, this);
-		}
-		else if (ModifierType == FModifierTags::Modifier_Snare)
-		{
-			SimulatedSnare = ModifierMovement->GetSnareLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedSnare, this);
-		}
-		else if (ModifierType == FModifierTags::Modifier_SlowFall)
-		{
-			SimulatedSlowFall = ModifierMovement->GetSlowFallLevelIndex(ModifierLevel);
-			MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, SimulatedSlowFall, this);
-		}
+		SimulatedLevelSetters[Channel](*this, ModifierLevelValue);
 	}
+
+	NotifyModifierChanged<uint8>(ModifierType, ModifierLevel, PrevModifierLevel, ModifierLevelValue,
+		PrevModifierLevelValue, NO_MODIFIER);
+}
+
+void AModifierCharacter::OnModifierChanged(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
+	const FGameplayTag& PrevModifierLevel)
+{
+	K2_OnModifierChanged(ModifierType, ModifierLevel, PrevModifierLevel);
 }
 
 void AModifierCharacter::OnModifierAdded(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
@@ -85,6 +115,7 @@ void AModifierCharacter::OnRep_SimulatedBoost(uint8 PrevLevel)
 	{
 		const FGameplayTag PrevBoostLevel = ModifierMovement->GetBoostLevel();
 		ModifierMovement->BoostLevel = SimulatedBoost;
+		ModifierMovement->UpdateEffectiveModifierParams();
 		NotifyModifierChanged<uint8>(FModifierTags::Modifier_Boost, ModifierMovement->GetBoostLevel(),
 			PrevBoostLevel, ModifierMovement->BoostLevel, PrevLevel, NO_MODIFIER);
 
@@ -119,6 +150,49 @@ bool AModifierCharacter::Boost(FGameplayTag Level, EModifierNetType NetType)
 	return false;
 }
 
+bool AModifierCharacter::BoostForDuration(FGameplayTag Level, EModifierNetType NetType, float Duration)
+{
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid() && Duration > 0.f)
+	{
+		const uint8 LevelIndex = ModifierMovement->GetBoostLevelIndex(Level);
+		if (LevelIndex == NO_MODIFIER)
+		{
+			return false;
+		}
+
+		const float ExpiryTimestamp = ModifierMovement->GetTimestamp() + Duration;
+		switch (NetType)
+		{
+		case EModifierNetType::LocalPredicted:
+			return ModifierMovement->BoostLocal.AddTimedModifier(LevelIndex, ExpiryTimestamp);
+		case EModifierNetType::WithCorrection:
+			return ModifierMovement->BoostCorrection.AddTimedModifier(LevelIndex, ExpiryTimestamp);
+		case EModifierNetType::ServerInitiated:
+			if (HasAuthority())
+			{
+				return ModifierMovement->BoostServer.AddTimedModifier(LevelIndex, ExpiryTimestamp);
+			}
+		default: return false;
+		}
+	}
+	return false;
+}
+
+bool AModifierCharacter::ScheduleBoost(FGameplayTag Level, float Duration)
+{
+	if (ModifierMovement && HasAuthority() && Level.IsValid())
+	{
+		const uint8 LevelIndex = ModifierMovement->GetBoostLevelIndex(Level);
+		if (LevelIndex == NO_MODIFIER)
+		{
+			return false;
+		}
+
+		return ModifierMovement->ScheduleModifier(ModifierMovement->BoostServer, LevelIndex, Duration);
+	}
+	return false;
+}
+
 bool AModifierCharacter::UnBoost(FGameplayTag Level, EModifierNetType NetType, bool bRemoveAll)
 {
 	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid())
@@ -187,6 +261,7 @@ void AModifierCharacter::OnRep_SimulatedSnare(uint8 PrevLevel)
 	{
 		const FGameplayTag PrevSnareLevel = ModifierMovement->GetSnareLevel();
 		ModifierMovement->SnareLevel = SimulatedSnare;
+		ModifierMovement->UpdateEffectiveModifierParams();
 		NotifyModifierChanged<uint8>(FModifierTags::Modifier_Snare, ModifierMovement->GetSnareLevel(),
 			PrevSnareLevel, ModifierMovement->SnareLevel, PrevLevel, NO_MODIFIER);
 
@@ -209,6 +284,36 @@ bool AModifierCharacter::Snare(FGameplayTag Level)
 	return false;
 }
 
+bool AModifierCharacter::SnareForDuration(FGameplayTag Level, float Duration)
+{
+	if (ModifierMovement && HasAuthority() && Level.IsValid() && Duration > 0.f)
+	{
+		const uint8 LevelIndex = ModifierMovement->GetSnareLevelIndex(Level);
+		if (LevelIndex == NO_MODIFIER)
+		{
+			return false;
+		}
+
+		return ModifierMovement->SnareServer.AddTimedModifier(LevelIndex, ModifierMovement->GetTimestamp() + Duration);
+	}
+	return false;
+}
+
+bool AModifierCharacter::ScheduleSnare(FGameplayTag Level, float Duration)
+{
+	if (ModifierMovement && HasAuthority() && Level.IsValid())
+	{
+		const uint8 LevelIndex = ModifierMovement->GetSnareLevelIndex(Level);
+		if (LevelIndex == NO_MODIFIER)
+		{
+			return false;
+		}
+
+		return ModifierMovement->ScheduleModifier(ModifierMovement->SnareServer, LevelIndex, Duration);
+	}
+	return false;
+}
+
 bool AModifierCharacter::UnSnare(FGameplayTag Level, bool bRemoveAll)
 {
 	if (ModifierMovement && HasAuthority() && Level.IsValid())
@@ -253,6 +358,7 @@ void AModifierCharacter::OnRep_SimulatedSlowFall(uint8 PrevLevel)
 	{
 		const FGameplayTag PrevSlowFallLevel = ModifierMovement->GetSlowFallLevel();
 		ModifierMovement->SlowFallLevel = SimulatedSlowFall;
+		ModifierMovement->UpdateEffectiveModifierParams();
 		NotifyModifierChanged<uint8>(FModifierTags::Modifier_SlowFall, ModifierMovement->GetSlowFallLevel(),
 			PrevSlowFallLevel, ModifierMovement->SlowFallLevel, PrevLevel, NO_MODIFIER);
 
@@ -275,6 +381,21 @@ bool AModifierCharacter::SlowFall(FGameplayTag Level)
 	return false;
 }
 
+bool AModifierCharacter::SlowFallForDuration(FGameplayTag Level, float Duration)
+{
+	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid() && Duration > 0.f)
+	{
+		const uint8 LevelIndex = ModifierMovement->GetSlowFallLevelIndex(Level);
+		if (LevelIndex == NO_MODIFIER)
+		{
+			return false;
+		}
+
+		return ModifierMovement->SlowFallLocal.AddTimedModifier(LevelIndex, ModifierMovement->GetTimestamp() + Duration);
+	}
+	return false;
+}
+
 bool AModifierCharacter::UnSlowFall(FGameplayTag Level, bool bRemoveAll)
 {
 	if (ModifierMovement && GetLocalRole() != ROLE_SimulatedProxy && Level.IsValid())
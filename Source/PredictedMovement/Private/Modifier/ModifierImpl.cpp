@@ -2,9 +2,8 @@
 
 
 #include "Modifier/ModifierImpl.h"
-#include "Algo/Accumulate.h"
-#include "Algo/MaxElement.h"
-#include "Algo/MinElement.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogModifier, Log, All);
 
 bool FModifierMoveData_LocalPredicted::Serialize(FArchive& Ar, const FString& ErrorName,
 	uint8 MaxSerializedModifiers)
@@ -24,67 +23,195 @@ bool FModifierMoveData_ServerInitiated::Serialize(FArchive& Ar, const FString& E
 	return FModifierStatics::NetSerialize(Modifiers, Ar, ErrorName, MaxSerializedModifiers);
 }
 
-TModSize FMovementModifier::GetNumWantedModifiersByLevel(TModSize Level) const
+void FModifierLevelCounts::Add(TModSize Level)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::GetNumWantedModifiersByLevel);
-	
-	return WantsModifiers.FilterByPredicate([Level](uint8 ModifierLevel)
+	if (Counts.Num() <= Level)
+	{
+		Counts.SetNumZeroed(Level + 1);
+	}
+	Counts[Level]++;
+
+	Super::Add(Level);
+}
+
+void FModifierLevelCounts::Remove(TModSize Level, int32 Count)
+{
+	Count = FMath::Min<int32>(Count, GetNum(Level));
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	Counts[Level] -= Count;
+	NumModifiers -= Count;
+	LevelSum -= Level * Count;
+
+	if (NumModifiers == 0)
+	{
+		MinLevel = NO_MODIFIER;
+		MaxLevel = NO_MODIFIER;
+		return;
+	}
+
+	// The bounds only move when their level empties, walk towards the remaining levels to find the new one
+	if (Counts[Level] == 0)
 	{
-		return ModifierLevel == Level;
-	}).Num();
+		if (Level == MinLevel)
+		{
+			while (Counts[MinLevel] == 0) { ++MinLevel; }
+		}
+		if (Level == MaxLevel)
+		{
+			while (Counts[MaxLevel] == 0) { --MaxLevel; }
+		}
+	}
+}
+
+void FModifierLevelCounts::Reset()
+{
+	Super::Reset();
+	Counts.Reset();
+}
+
+void FModifierLevelCounts::Rebuild(const TModifierStack& Stack)
+{
+	Reset();
+	for (const TModSize Level : Stack)
+	{
+		Add(Level);
+	}
+}
+
+TModSize FMovementModifier::GetNumWantedModifiersByLevel(TModSize Level) const
+{
+	return WantsCounts.GetNum(Level);
 }
 
 TModSize FMovementModifier::GetNumModifiersByLevel(TModSize Level) const
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::GetNumModifiersByLevel);
-	
-	return Modifiers.FilterByPredicate([Level](uint8 ModifierLevel)
+	return ModifierCounts.GetNum(Level);
+}
+
+int32 FMovementModifier::LimitNumModifiers(int32 NumModifiers, int32& RemainingModifiers)
+{
+	// If MaxModifiers is 0 or less, we can't have any modifiers, otherwise the oldest entries (from the start) are left out
+	const int32 NumApplied = FMath::Clamp(RemainingModifiers, 0, NumModifiers);
+	RemainingModifiers = FMath::Max(RemainingModifiers - NumApplied, 0);
+	return NumApplied;
+}
+
+bool FMovementModifier::ExpireModifiers(float Timestamp)
+{
+	bool bExpired = false;
+	for (int32 Index = 0; Index < Timers.Num();)
 	{
-		return ModifierLevel == Level;
-	}).Num();
+		if (Timestamp < Timers[Index].ExpiryTimestamp)
+		{
+			Index++;
+			continue;
+		}
+
+		// Removes the oldest wanted modifier of the level, both sides hold the same stack so they remove the same entry
+		const TModSize Level = Timers[Index].Level;
+		Timers.RemoveAt(Index, 1, EAllowShrinking::No);
+		if (WantsCounts.Contains(Level))
+		{
+			WantsModifiers.RemoveSingle(Level);
+			WantsCounts.Remove(Level);
+			bExpired = true;
+		}
+	}
+
+	if (bExpired)
+	{
+		WantsGeneration++;
+	}
+	return bExpired;
 }
 
-void FMovementModifier::LimitNumModifiers(TModifierStack& Modifiers, int32& RemainingModifiers)
+bool FMovementModifier::StartScheduledModifiers(float Timestamp)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::LimitNumModifiers);
-	
-	if (Modifiers.Num() > RemainingModifiers)
+	bool bStarted = false;
+	for (int32 Index = 0; Index < Schedules.Num();)
 	{
-		// Limit the number of modifiers to the maximum allowed
-		if (RemainingModifiers <= 0)
+		if (Timestamp < Schedules[Index].StartTimestamp)
 		{
-			// If MaxModifiers is 0 or less, we can't have any modifiers
-			Modifiers.Reset();
+			Index++;
+			continue;
+		}
+
+		const FModifierSchedule Schedule = Schedules[Index];
+		Schedules.RemoveAt(Index, 1, EAllowShrinking::No);
+		if (Schedule.Duration > 0.f)
+		{
+			AddTimedModifier(Schedule.Level, Schedule.StartTimestamp + Schedule.Duration);
 		}
 		else
 		{
-			// Remove the oldest entries (from the start)
-			const int32 NumToRemove = Modifiers.Num() - RemainingModifiers;
-			Modifiers.RemoveAt(0, NumToRemove, EAllowShrinking::No);
+			AddModifier(Schedule.Level);
+		}
+		bStarted = true;
+	}
+	return bStarted;
+}
+
+void FMovementModifier::ReceiveSchedules(const TModifierSchedules& InSchedules, uint16& LastScheduleId)
+{
+	for (const FModifierSchedule& Schedule : InSchedules)
+	{
+		// Sequence comparison, so the id can wrap
+		if (static_cast<int16>(Schedule.Id - LastScheduleId) > 0)
+		{
+			Schedules.Add(Schedule);
+			LastScheduleId = Schedule.Id;
 		}
 	}
+}
 
-	RemainingModifiers = FMath::Max(RemainingModifiers - Modifiers.Num(), 0);
+void FMovementModifier::TrimTimers()
+{
+	for (int32 Index = 0; Index < Timers.Num();)
+	{
+		const TModSize Level = Timers[Index].Level;
+		int32 NumTimers = 0;
+		for (const FModifierTimer& Timer : Timers)
+		{
+			NumTimers += Timer.Level == Level ? 1 : 0;
+		}
+
+		if (NumTimers > WantsCounts.GetNum(Level))
+		{
+			Timers.RemoveAt(Index, 1, EAllowShrinking::No);
+		}
+		else
+		{
+			Index++;
+		}
+	}
 }
 
 bool FMovementModifier::UpdateMovementState(bool bAllowedInCurrentState, bool bClampMax, int32& Remaining)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMovementModifier::UpdateMovementState);
 	
-	// Only update the modifiers if the current state allows it
-	TModifierStack CurrentModifiers = bAllowedInCurrentState ? WantsModifiers : TModifierStack();
+	// Only apply the modifiers if the current state allows it
+	int32 NumToApply = bAllowedInCurrentState ? WantsModifiers.Num() : 0;
 
-	// Clamp the number of modifiers to the maximum allowed -- this removes old modifiers first
-	// Note: There may be potential for de-sync if client removes server modifiers out of order (cross that bridge when we get there)
+	// Clamp the number of modifiers to the maximum allowed -- this leaves out old modifiers first, without removing them
 	if (bAllowedInCurrentState && bClampMax)
 	{
-		LimitNumModifiers(CurrentModifiers, Remaining);
+		NumToApply = LimitNumModifiers(NumToApply, Remaining);
 	}
 
-	// If the modifiers have changed, update the data
-	if (Modifiers != CurrentModifiers)
+	// The applied modifiers are the newest NumToApply entries of WantsModifiers
+	const TModSize* Applied = WantsModifiers.GetData() + (WantsModifiers.Num() - NumToApply);
+
+	// If the modifiers have changed, update the data in place -- Modifiers keeps its inline storage
+	if (Modifiers.Num() != NumToApply || !CompareItems(Modifiers.GetData(), Applied, NumToApply))
 	{
-		Modifiers = CurrentModifiers;
+		Modifiers.Reset();
+		Modifiers.Append(Applied, NumToApply);
+		ModifierCounts.Rebuild(Modifiers);
 		return true;
 	}
 	return false;
@@ -95,8 +222,12 @@ bool FModifierStatics::NetSerialize(TModifierStack& Modifiers, FArchive& Ar, con
 	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::NetSerialize);
 	
 	// Don't serialize modifier stack if the max is 0
-	if (MaxSerializedModifiers <= 1)
+	if (MaxSerializedModifiers == 0)
 	{
+		if (Ar.IsLoading())
+		{
+			Modifiers.Reset();
+		}
 		return !Ar.IsError();
 	}
 	
@@ -119,158 +250,328 @@ bool FModifierStatics::NetSerialize(TModifierStack& Modifiers, FArchive& Ar, con
 		Modifiers.SetNum(NumModifiers);
 	}
 
-	// Serialize the elements
+	// Serialize the newest elements, which are the ones applied when the stack exceeds the max
+	const int32 First = Ar.IsSaving() ? Modifiers.Num() - NumModifiers : 0;
 	for (TModSize i = 0; i < NumModifiers; ++i)
 	{
-		Ar << Modifiers[i];
+		Ar << Modifiers[First + i];
 	}
 
 	return !Ar.IsError();
 }
 
-TModSize FModifierStatics::UpdateModifierLevel(EModifierLevelMethod Method, const TModifierStack& Modifiers,
-	TModSize MaxLevel, TModSize InvalidLevel)
+bool FModifierStatics::NetSerializePacked(TModifierStack& Modifiers, FArchive& Ar, const FString& ErrorName,
+	int32 NumLevels, int32 MaxSerializedModifiers)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::UpdateModifierLevel);
-	
-	if (Modifiers.IsEmpty())
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::NetSerializePacked);
+
+	// Exclusive bounds of the serialized values
+	const uint32 LevelMax = static_cast<uint32>(FMath::Clamp(NumLevels, 1, static_cast<int32>(NO_MODIFIER)));
+	const uint32 Cap = static_cast<uint32>(FMath::Clamp(MaxSerializedModifiers, 0, NO_MODIFIER - 1));
+
+	// Don't serialize modifier stack if the max is 0
+	if (Cap == 0)
 	{
-		return InvalidLevel;
+		if (Ar.IsLoading())
+		{
+			Modifiers.Reset();
+		}
+		return !Ar.IsError();
 	}
 
-	TModSize NewLevel;
+	// Serialize the newest elements, which are the ones applied when the stack exceeds the max
+	const uint32 NumSaved = Ar.IsSaving() ? FMath::Min(static_cast<uint32>(Modifiers.Num()), Cap) : 0;
+	const int32 First = Modifiers.Num() - NumSaved;
 
-	switch (Method)
+	// Levels are stacked repeatedly, e.g. the same Snare applied by several sources, so count the runs of equal levels
+	uint32 NumRuns = 0;
+	for (uint32 i = 0; i < NumSaved; i++)
 	{
-	case EModifierLevelMethod::Max:
-		NewLevel = *Algo::MaxElement(Modifiers);
-		break;
+		NumRuns += (i == 0 || Modifiers[First + i] != Modifiers[First + i - 1]) ? 1 : 0;
+	}
 
-	case EModifierLevelMethod::Min:
-		NewLevel = *Algo::MinElement(Modifiers);
-		break;
+	// Run length encode when it is smaller, each run costs a level and a length instead of a level per modifier
+	const uint32 LevelBits = FMath::CeilLogTwo(LevelMax);
+	const uint32 CountBits = FMath::CeilLogTwo(Cap);
+	bool bRunLength = Ar.IsSaving() && NumRuns * (LevelBits + CountBits) < NumSaved * LevelBits;
+	Ar.SerializeBits(&bRunLength, 1);
 
-	case EModifierLevelMethod::Stack:
+	// Bit readers can't read past the max, but other archives read the whole value, so reject anything out of range
+	auto SerializeBounded = [&Ar](uint32& Value, uint32 Max)
+	{
+		Ar.SerializeInt(Value, Max);
+		if (Ar.IsLoading() && Value >= Max)
 		{
-			uint64 Total = 0;
-			for (const TModSize& Level : Modifiers)
-			{
-				// We are only counting the number of modifiers, so we add 1 because levels are 0-based
-				Total += Level + 1;
-			}
+			Ar.SetError();
+			return false;
+		}
+		return true;
+	};
 
-			// Subtract 1 to convert back to 0-based level
-			NewLevel = Total > 0 ? Total - 1 : 0;
+	// Levels are indices into the channel's levels, fail rather than send a different level than the one simulated
+	auto SerializeLevel = [&Ar, &ErrorName, &SerializeBounded, LevelMax](TModSize& Level)
+	{
+		uint32 Value = Level;
+		if (Ar.IsSaving() && Value >= LevelMax)
+		{
+			UE_LOG(LogModifier, Error, TEXT("Serializing modifier %s level %u when it has %u levels -- Levels can't be added after the component registers"),
+				*ErrorName, Value, LevelMax);
+			Ar.SetError();
+			return false;
 		}
-		break;
+		if (!SerializeBounded(Value, LevelMax))
+		{
+			return false;
+		}
+		Level = static_cast<TModSize>(Value);
+		return true;
+	};
 
-	case EModifierLevelMethod::Average:
+	if (!bRunLength)
+	{
+		uint32 NumModifiers = NumSaved;
+		if (!SerializeBounded(NumModifiers, Cap + 1))
+		{
+			return false;
+		}
+
+		if (Ar.IsLoading())
+		{
+			Modifiers.SetNum(NumModifiers);
+		}
+
+		for (uint32 i = 0; i < NumModifiers; i++)
 		{
-			uint64 Total = 0;
-			for (const TModSize& Level : Modifiers)
+			TModSize Level = Ar.IsSaving() ? Modifiers[First + i] : 0;
+			if (!SerializeLevel(Level))
+			{
+				return false;
+			}
+			if (Ar.IsLoading())
 			{
-				// We don't add 1 here because we are averaging the levels, not counting them
-				Total += Level;
+				Modifiers[i] = Level;
 			}
-			NewLevel = static_cast<TModSize>(Total / Modifiers.Num());
 		}
-		break;
-
-	default:
-		return InvalidLevel;
+		return !Ar.IsError();
 	}
 
-	// Clamp to max allowed
-	return FMath::Clamp(NewLevel, 0, MaxLevel);
-}
-
-TModSize FModifierStatics::CombineModifierLevels(EModifierLevelMethod Method, const TModifierStack& ModifierLevels,
-	TModSize MaxLevel, TModSize InvalidLevel)
-{
-	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::CombineModifierLevels);
-	
-	if (ModifierLevels.IsEmpty())
+	if (!SerializeBounded(NumRuns, Cap + 1))
 	{
-		return InvalidLevel;
+		return false;
 	}
 
-	TModSize NewLevel;
-
-	switch (Method)
+	if (Ar.IsLoading())
 	{
-	case EModifierLevelMethod::Max:
-		NewLevel = *Algo::MaxElement(ModifierLevels);
-		break;
-
-	case EModifierLevelMethod::Min:
-		NewLevel = *Algo::MinElement(ModifierLevels);
-		break;
+		Modifiers.Reset();
+	}
 
-	case EModifierLevelMethod::Stack:
+	int32 Index = First;
+	for (uint32 Run = 0; Run < NumRuns; Run++)
+	{
+		// The length of a run is at least 1, so send one less
+		uint32 ExtraLength = 0;
+		TModSize Level = 0;
+		if (Ar.IsSaving())
 		{
-			uint64 Total = 0;
-			for (const TModSize& Level : ModifierLevels)
+			Level = Modifiers[Index];
+			const int32 RunStart = Index;
+			while (Index < Modifiers.Num() && Modifiers[Index] == Level)
 			{
-				// We are only counting the number of modifiers, so we add 1 because levels are 0-based
-				Total += Level + 1;
+				Index++;
 			}
+			ExtraLength = Index - RunStart - 1;
+		}
 
-			// Subtract 1 to convert back to 0-based level
-			NewLevel = Total > 0 ? Total - 1 : 0;
+		if (!SerializeLevel(Level) || !SerializeBounded(ExtraLength, Cap))
+		{
+			return false;
 		}
-		break;
 
-	case EModifierLevelMethod::Average:
+		if (Ar.IsLoading())
 		{
-			uint64 Total = 0;
-			for (const TModSize& Level : ModifierLevels)
+			// Runs that add up to more than the cap come from a malformed packet
+			if (Modifiers.Num() + ExtraLength + 1 > Cap)
 			{
-				Total += Level;
+				Ar.SetError();
+				return false;
+			}
+			for (uint32 i = 0; i <= ExtraLength; i++)
+			{
+				Modifiers.Add(Level);
 			}
-			NewLevel = static_cast<TModSize>(Total / ModifierLevels.Num());
 		}
-		break;
+	}
 
-	default:
-		return InvalidLevel;
+	return !Ar.IsError();
+}
+
+bool FModifierStatics::NetSerialize(TModifierTimers& Timers, FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedTimers)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::NetSerializeTimers);
+
+	// Clamp before narrowing, otherwise a multiple of 256 timers would be sent as none
+	uint8 NumTimers = Ar.IsSaving() ? static_cast<uint8>(FMath::Min<int32>(Timers.Num(), MaxSerializedTimers)) : 0;
+	Ar << NumTimers;
+
+	if (Ar.IsLoading())
+	{
+		// Reading fewer timers than were written would misread every later field, so reject the packet instead
+		if (NumTimers > MaxSerializedTimers)
+		{
+			Ar.SetError();
+			return false;
+		}
+		Timers.SetNum(NumTimers);
+	}
+
+	// Serialize the newest timers, matching the newest modifiers sent alongside them
+	const int32 First = Ar.IsSaving() ? Timers.Num() - NumTimers : 0;
+	for (uint8 i = 0; i < NumTimers; ++i)
+	{
+		Ar << Timers[First + i];
 	}
 
-	// Clamp to max allowed
-	return FMath::Clamp(NewLevel, 0, MaxLevel);
+	return !Ar.IsError();
 }
 
-bool FModifierStatics::ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method,
-	const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
-	const TArray<FMovementModifier*>& Modifiers, const TFunctionRef<bool()>& CanActivateCallback)
+bool FModifierStatics::NetSerialize(TModifierSchedules& Schedules, FArchive& Ar, const FString& ErrorName,
+	uint8 MaxSerializedSchedules)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::ProcessModifiers);
-	
-	const TModSize PrevLevel = CurrentLevel;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::NetSerializeSchedules);
+
+	// Clamp before narrowing, see NetSerialize(TModifierTimers&)
+	uint8 NumSchedules = Ar.IsSaving() ? static_cast<uint8>(FMath::Min<int32>(Schedules.Num(), MaxSerializedSchedules)) : 0;
+	Ar << NumSchedules;
+
+	if (Ar.IsLoading())
+	{
+		if (NumSchedules > MaxSerializedSchedules)
+		{
+			Ar.SetError();
+			return false;
+		}
+		Schedules.SetNum(NumSchedules);
+	}
+
+	// The oldest schedules start first, any others are sent once these have started
+	for (uint8 i = 0; i < NumSchedules; ++i)
+	{
+		Ar << Schedules[i];
+	}
+
+	return !Ar.IsError();
+}
 
-	// Determine the maximum level based on the available tags
-	const TModSize MaxLevel = LevelTags.Num() > 0 ? static_cast<TModSize>(LevelTags.Num() - 1) : 0;
+TModSize FModifierStatics::UpdateModifierLevel(EModifierLevelMethod Method, const TModifierStack& Modifiers,
+	TModSize MaxLevel, TModSize InvalidLevel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::UpdateModifierLevel);
 
-	// Track modifier data
-	bool bStateChanged = false;
-	TArray<TModSize> Levels;
-	int32 Remaining = MaxModifiers;
+	FModifierLevelAggregate Levels;
+	for (const TModSize Level : Modifiers)
+	{
+		Levels.Add(Level);
+	}
+	return UpdateModifierLevel(Method, Levels, MaxLevel, InvalidLevel);
+}
 
-	// Iterate through all modifiers and update their state
-	for (FMovementModifier* Modifier : Modifiers)
+TModSize FModifierStatics::UpdateModifierLevel(EModifierLevelMethod Method, const FModifierLevelAggregate& Counts,
+	TModSize MaxLevel, TModSize InvalidLevel)
+{
+	switch (Method)
 	{
-		// Track if any state changed
-		bStateChanged |= Modifier->UpdateMovementState(CanActivateCallback(), bLimitMaxModifiers, Remaining);
+	case EModifierLevelMethod::Max: return UpdateModifierLevel<EModifierLevelMethod::Max>(Counts, MaxLevel, InvalidLevel);
+	case EModifierLevelMethod::Min: return UpdateModifierLevel<EModifierLevelMethod::Min>(Counts, MaxLevel, InvalidLevel);
+	case EModifierLevelMethod::Stack: return UpdateModifierLevel<EModifierLevelMethod::Stack>(Counts, MaxLevel, InvalidLevel);
+	case EModifierLevelMethod::Average: return UpdateModifierLevel<EModifierLevelMethod::Average>(Counts, MaxLevel, InvalidLevel);
+	default: return InvalidLevel;
+	}
+}
+
+TModSize FModifierStatics::CombineModifierLevels(EModifierLevelMethod Method, const TModifierStack& ModifierLevels,
+	TModSize MaxLevel, TModSize InvalidLevel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::CombineModifierLevels);
+
+	// Combining levels resolves exactly like a stack of modifiers at those levels
+	return UpdateModifierLevel(Method, ModifierLevels, MaxLevel, InvalidLevel);
+}
+
+bool FModifierStatics::ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method,
+	const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
+	TArrayView<FMovementModifier* const> Modifiers, const TFunctionRef<bool()>& CanActivateCallback)
+{
+	// The state applies to every modifier in the channel, so only query it once
+	return ProcessModifierLevels(CurrentLevel, Method, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel,
+		Modifiers, CanActivateCallback());
+}
 
-		// Always read and process the current modifier data
-		const TModSize NewLevel = UpdateModifierLevel(Method, Modifier->Modifiers, MaxLevel, InvalidLevel);
-		if (NewLevel != InvalidLevel)
+bool FModifierStatics::ProcessModifierLevels(TModSize& CurrentLevel, EModifierLevelMethod Method,
+	const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
+	TArrayView<FMovementModifier* const> Modifiers, bool bCanActivate)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierStatics::ProcessModifierLevels);
+
+	// Dispatch once per channel rather than once per modifier
+	switch (Method)
+	{
+	case EModifierLevelMethod::Max:
+		return ProcessModifierLevels<EModifierLevelMethod::Max>(CurrentLevel, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel, Modifiers, bCanActivate);
+	case EModifierLevelMethod::Min:
+		return ProcessModifierLevels<EModifierLevelMethod::Min>(CurrentLevel, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel, Modifiers, bCanActivate);
+	case EModifierLevelMethod::Stack:
+		return ProcessModifierLevels<EModifierLevelMethod::Stack>(CurrentLevel, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel, Modifiers, bCanActivate);
+	case EModifierLevelMethod::Average:
+		return ProcessModifierLevels<EModifierLevelMethod::Average>(CurrentLevel, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel, Modifiers, bCanActivate);
+	default:
 		{
-			Levels.Add(NewLevel);
+			const TModSize PrevLevel = CurrentLevel;
+			CurrentLevel = InvalidLevel;
+			return CurrentLevel != PrevLevel;
 		}
 	}
+}
 
-	// Combine all active modifier levels
-	CurrentLevel = Levels.Num() > 0 ? CombineModifierLevels(Method, Levels, MaxLevel, InvalidLevel) : InvalidLevel;
+bool FModifierStatics::UpdateDirtyState(FModifierChannelDirtyState& DirtyState,
+	TArrayView<FMovementModifier* const> Modifiers, const TFunctionRef<bool()>& CanActivateCallback)
+{
+	uint32 Generation = 0;
+	bool bHasModifiers = false;
+	for (const FMovementModifier* Modifier : Modifiers)
+	{
+		Generation += Modifier->WantsGeneration;
+		bHasModifiers |= Modifier->WantsModifiers.Num() > 0 || Modifier->Modifiers.Num() > 0;
+	}
+
+	const bool bInputsChanged = DirtyState.bDirty || Generation != DirtyState.Generation;
+
+	// Nothing wanted and nothing applied, so the state can't affect the result
+	if (!bInputsChanged && !bHasModifiers)
+	{
+		return false;
+	}
+
+	const bool bCanActivate = CanActivateCallback();
+	if (!bInputsChanged && bCanActivate == DirtyState.bCanActivate)
+	{
+		return false;
+	}
+
+	DirtyState.Generation = Generation;
+	DirtyState.bCanActivate = bCanActivate;
+	DirtyState.bDirty = false;
+	return true;
+}
+
+bool FModifierStatics::ProcessModifiers(FModifierChannelDirtyState& DirtyState, TModSize& CurrentLevel,
+	EModifierLevelMethod Method, const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers,
+	TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers, const TFunctionRef<bool()>& CanActivateCallback)
+{
+	if (!UpdateDirtyState(DirtyState, Modifiers, CanActivateCallback))
+	{
+		return false;
+	}
 
-	return bStateChanged || CurrentLevel != PrevLevel;
+	return ProcessModifierLevels(CurrentLevel, Method, LevelTags, bLimitMaxModifiers, MaxModifiers, InvalidLevel,
+		Modifiers, DirtyState.bCanActivate);
 }
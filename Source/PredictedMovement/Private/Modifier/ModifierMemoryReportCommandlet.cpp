@@ -0,0 +1,119 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierMemoryReportCommandlet.h"
+
+#include "Modifier/ModifierMovement.h"
+#include "Modifier/ModifierMovementConfig.h"
+#include "UObject/Package.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierMemoryReportCommandlet)
+
+DEFINE_LOG_CATEGORY_STATIC(LogModifierMemoryReport, Log, All);
+
+namespace ModifierMemoryReportPrivate
+{
+	/** Held by every component before sharing: the params, levels and table refs that now live on the config */
+	constexpr SIZE_T UnsharedInlineBytes = sizeof(UModifierMovementConfig) - sizeof(UDataAsset);
+
+	/** Held by every component now: the config, its own copy of it, and the table refs */
+	constexpr SIZE_T SharedInlineBytes = sizeof(TObjectPtr<UModifierMovementConfig>) * 2
+		+ sizeof(UModifierMovement::BoostLevelTable) + sizeof(UModifierMovement::SnareLevelTable)
+		+ sizeof(UModifierMovement::SlowFallLevelTable);
+
+	/** Count the heap of a table the first time it is seen */
+	template<typename T>
+	SIZE_T GetUniqueTableBytes(const TSharedRef<const TModifierLevelTable<T>>& Table, TSet<const void*>& UniqueTables)
+	{
+		bool bAlreadyCounted = false;
+		UniqueTables.Add(&Table.Get(), &bAlreadyCounted);
+		return bAlreadyCounted ? 0 : Table->GetAllocatedSize();
+	}
+}
+
+UModifierMemoryReportCommandlet::UModifierMemoryReportCommandlet(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = true;
+	LogToConsole = true;
+}
+
+int32 UModifierMemoryReportCommandlet::Main(const FString& Params)
+{
+	using namespace ModifierMemoryReportPrivate;
+
+	int32 NumCharacters = 1500;
+	FParse::Value(*Params, TEXT("Count="), NumCharacters);
+	NumCharacters = FMath::Max(NumCharacters, 1);
+
+	int32 NumOverrides = 0;
+	FParse::Value(*Params, TEXT("Overrides="), NumOverrides);
+	NumOverrides = FMath::Clamp(NumOverrides, 0, NumCharacters);
+
+	const UModifierMovementConfig* Config = nullptr;
+	FString ConfigPath;
+	if (FParse::Value(*Params, TEXT("Config="), ConfigPath))
+	{
+		Config = LoadObject<UModifierMovementConfig>(nullptr, *ConfigPath);
+		if (!Config)
+		{
+			UE_LOG(LogModifierMemoryReport, Error, TEXT("Failed to load modifier config '%s'"), *ConfigPath);
+			return 1;
+		}
+	}
+
+	// Bake the components as OnRegister() would, overriding components take their own copy of the config
+	TArray<TStrongObjectPtr<UModifierMovement>> Components;
+	Components.Reserve(NumCharacters);
+	for (int32 Index = 0; Index < NumCharacters; Index++)
+	{
+		UModifierMovement* Movement = NewObject<UModifierMovement>(GetTransientPackage());
+		Movement->ModifierConfig = Config;
+		if (Index < NumOverrides)
+		{
+			Movement->GetMutableModifierConfig();
+		}
+		Movement->BakeModifierLevels();
+		Components.Emplace(Movement);
+	}
+
+	// Before, every character held its own params and baked its own tables
+	SIZE_T UnsharedBytes = 0;
+
+	// Now, each config and table is counted once no matter how many characters point at it
+	SIZE_T SharedBytes = 0;
+	TSet<const UModifierMovementConfig*> UniqueConfigs;
+	TSet<const void*> UniqueTables;
+
+	for (const TStrongObjectPtr<UModifierMovement>& Movement : Components)
+	{
+		const UModifierMovementConfig* MovementConfig = Movement->GetModifierConfig();
+		const SIZE_T ParamsBytes = MovementConfig->GetParamsAllocatedSize();
+
+		UnsharedBytes += UnsharedInlineBytes + ParamsBytes + Movement->BoostLevelTable->GetAllocatedSize()
+			+ Movement->SnareLevelTable->GetAllocatedSize() + Movement->SlowFallLevelTable->GetAllocatedSize();
+
+		SharedBytes += SharedInlineBytes;
+		bool bAlreadyCounted = false;
+		UniqueConfigs.Add(MovementConfig, &bAlreadyCounted);
+		if (!bAlreadyCounted)
+		{
+			SharedBytes += sizeof(UModifierMovementConfig) + ParamsBytes;
+		}
+		SharedBytes += GetUniqueTableBytes(Movement->BoostLevelTable, UniqueTables);
+		SharedBytes += GetUniqueTableBytes(Movement->SnareLevelTable, UniqueTables);
+		SharedBytes += GetUniqueTableBytes(Movement->SlowFallLevelTable, UniqueTables);
+	}
+
+	UE_LOG(LogModifierMemoryReport, Display, TEXT("Modifier memory: %d characters, %d overriding their config, %d unique configs, %d unique level tables"),
+		NumCharacters, NumOverrides, UniqueConfigs.Num(), UniqueTables.Num());
+	UE_LOG(LogModifierMemoryReport, Display, TEXT("  Before (params and level tables per character): %llu bytes per character, %llu bytes total"),
+		static_cast<uint64>(UnsharedBytes / NumCharacters), static_cast<uint64>(UnsharedBytes));
+	UE_LOG(LogModifierMemoryReport, Display, TEXT("  After (shared config): %llu bytes per character, %llu bytes total"),
+		static_cast<uint64>(SharedBytes / NumCharacters), static_cast<uint64>(SharedBytes));
+
+	return 0;
+}
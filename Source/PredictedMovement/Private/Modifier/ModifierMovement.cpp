@@ -3,9 +3,12 @@
 
 #include "Modifier/ModifierMovement.h"
 
+#include "Modifier/ModifierAgent.h"
 #include "Modifier/ModifierCharacter.h"
 #include "Modifier/ModifierTags.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
 
 #if WITH_EDITOR
 #include "Misc/DataValidation.h"
@@ -34,14 +37,27 @@ UModifierMovement::UModifierMovement(const FObjectInitializer& ObjectInitializer
 	SetNetworkMoveDataContainer(ModifierMoveDataContainer);
 	SetMoveResponseDataContainer(ModifierMoveResponseDataContainer);
 
-	// Init Modifier Levels
-	Boost.Add(FModifierTags::Modifier_Boost, { 1.50f });  // 50% Speed Boost
-	Snare.Add(FModifierTags::Modifier_Snare, { 0.50f });  // 50% Speed Snare
-	SlowFall.Add(FModifierTags::Modifier_SlowFall, { 0.1f });  // 90% Gravity Reduction
-
-	// Auth params for Snare
-	static constexpr int32 DefaultPriority = 5;
-	ClientAuthParams.FindOrAdd(FModifierTags::ClientAuth_Snare, { DefaultPriority });
+	// Register Modifier channels -- Modifiers are added in priority order, which is also their serialization order
+	{
+		const int32 Channel = ModifierRegistry.AddChannel({ FModifierTags::Modifier_Boost, &BoostLevel, &BoostLevelTable->Levels,
+			&BoostLevelMethod, &bLimitMaxBoosts, &MaxBoosts, &BoostLevelTable->Params, nullptr,
+			[this] { return CanBoostInCurrentState(); } });
+		ModifierRegistry.AddModifier(Channel, BoostLocal, EModifierNetType::LocalPredicted, TEXT("BoostLocal"));
+		ModifierRegistry.AddModifier(Channel, BoostCorrection, EModifierNetType::WithCorrection, TEXT("BoostCorrection"));
+		ModifierRegistry.AddModifier(Channel, BoostServer, EModifierNetType::ServerInitiated, TEXT("BoostServer"));
+	}
+	{
+		const int32 Channel = ModifierRegistry.AddChannel({ FModifierTags::Modifier_Snare, &SnareLevel, &SnareLevelTable->Levels,
+			&SnareLevelMethod, &bLimitMaxSnares, &MaxSnares, &SnareLevelTable->Params, nullptr,
+			[this] { return CanSnareInCurrentState(); } });
+		ModifierRegistry.AddModifier(Channel, SnareServer, EModifierNetType::ServerInitiated, TEXT("SnareServer"));
+	}
+	{
+		const int32 Channel = ModifierRegistry.AddChannel({ FModifierTags::Modifier_SlowFall, &SlowFallLevel, &SlowFallLevelTable->Levels,
+			&SlowFallLevelMethod, &bLimitMaxSlowFalls, &MaxSlowFalls, nullptr, &SlowFallLevelTable->Params,
+			[this] { return CanSlowFallInCurrentState(); } });
+		ModifierRegistry.AddModifier(Channel, SlowFallLocal, EModifierNetType::LocalPredicted, TEXT("SlowFallLocal"));
+	}
 }
 
 void FModifierMoveResponseDataContainer::ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement,
@@ -55,15 +71,33 @@ void FModifierMoveResponseDataContainer::ServerFillResponseData(const UCharacter
 	// ServerFillResponseData ➜ MoveResponsePacked_ServerSend >> Client 
 	
 	const UModifierMovement* MoveComp = Cast<UModifierMovement>(&CharacterMovement);
+	const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
 
 	// Fill the response data with the current modifier state
-	BoostCorrection.ServerFillResponseData(MoveComp->BoostCorrection.Modifiers);
-	BoostServer.ServerFillResponseData(MoveComp->BoostServer.Modifiers);
-	SnareServer.ServerFillResponseData(MoveComp->SnareServer.Modifiers);
+	Modifiers.SetNum(Registry.NumModifiers());
+	for (int32 Slot = 0; Slot < Registry.NumModifiers(); Slot++)
+	{
+		if (Registry.HasServerTimers(Slot))
+		{
+			Modifiers[Slot].ServerFillResponseData(Registry.Modifiers[Slot]->Modifiers, Registry.Modifiers[Slot]->Timers);
+			Modifiers[Slot].Schedules = Registry.Modifiers[Slot]->Schedules;
+		}
+		else if (Registry.HasServerCorrection(Slot))
+		{
+			Modifiers[Slot].ServerFillResponseData(Registry.Modifiers[Slot]->Modifiers);
+		}
+
+		// Positional corrections usually leave every stack as the client had it
+		Modifiers[Slot].bMatchesClient = Registry.HasServerCorrection(Slot) &&
+			MoveComp->DoesClientStackMatch(Slot, PendingAdjustment.TimeStamp);
+	}
 
 	// Fill ClientAuthAlpha
 	ClientAuthAlpha = MoveComp->ClientAuthAlpha;
-	bHasClientAuthAlpha = ClientAuthAlpha > 0.f;
+	bHasClientAuthAlpha = QuantizeClientAuthAlpha(ClientAuthAlpha) > 0;
+
+	// A full correction carries the stacks anyway
+	bHasStateCorrection = !IsCorrection() && MoveComp->HasPendingStateCorrection();
 }
 
 bool FModifierMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
@@ -75,28 +109,75 @@ bool FModifierMoveResponseDataContainer::Serialize(UCharacterMovementComponent&
 	}
 
 	// Server ➜ Client
+	const UModifierMovement& MoveComp = static_cast<const UModifierMovement&>(CharacterMovement);
+
+	// Serialize scheduled modifiers, with acks too, so they reach the client before they start
+	if (!MoveComp.GetModifierRegistry().NetSerializeSchedules(Modifiers, Ar))
+	{
+		return false;
+	}
+	
 	if (IsCorrection())
 	{
 		// Serialize Modifiers
-		Ar << BoostCorrection.Modifiers;
-		Ar << BoostServer.Modifiers;
-		Ar << SnareServer.Modifiers;
+		if (!MoveComp.GetModifierRegistry().NetSerializeMoveResponse(Modifiers, Ar))
+		{
+			return false;
+		}
 
 		// Serialize ClientAuthAlpha
 		Ar.SerializeBits(&bHasClientAuthAlpha, 1);
 		if (bHasClientAuthAlpha)
 		{
-			Ar << ClientAuthAlpha;
+			uint8 QuantizedAlpha = QuantizeClientAuthAlpha(ClientAuthAlpha);
+			Ar << QuantizedAlpha;
+			ClientAuthAlpha = DequantizeClientAuthAlpha(QuantizedAlpha);
 		}
 		else if (!Ar.IsSaving())
 		{
 			ClientAuthAlpha = 0.f;
 		}
 	}
+	else
+	{
+		// State-only correction, piggy-backed on the ack
+		Ar.SerializeBits(&bHasStateCorrection, 1);
+		if (bHasStateCorrection && !MoveComp.GetModifierRegistry().NetSerializeMoveResponse(Modifiers, Ar))
+		{
+			return false;
+		}
+	}
+
+	if (Ar.IsLoading() && !Ar.IsError() && (IsCorrection() || bHasStateCorrection))
+	{
+		RestoreClientModifiers(CharacterMovement);
+	}
 
 	return !Ar.IsError();
 }
 
+void FModifierMoveResponseDataContainer::RestoreClientModifiers(UCharacterMovementComponent& CharacterMovement)
+{
+	// Omitted stacks are the ones the client sent with the corrected move, which its saved move keeps apart from any rewrite
+	const FNetworkPredictionData_Client_Character* ClientData = CharacterMovement.GetPredictionData_Client_Character();
+	const int32 MoveIndex = ClientData ? ClientData->GetSavedMoveIndex(ClientAdjustment.TimeStamp) : INDEX_NONE;
+	const FSavedMove_Character_Modifier* SavedMove = MoveIndex != INDEX_NONE ?
+		static_cast<const FSavedMove_Character_Modifier*>(ClientData->SavedMoves[MoveIndex].Get()) : nullptr;
+
+	const FModifierRegistry& Registry = static_cast<const UModifierMovement&>(CharacterMovement).GetModifierRegistry();
+	for (int32 Slot = 0; Slot < Modifiers.Num(); Slot++)
+	{
+		if (!Modifiers[Slot].bMatchesClient)
+		{
+			continue;
+		}
+
+		// The move should always be saved, if not the current stack is the closest we have
+		Modifiers[Slot].Modifiers = SavedMove && SavedMove->Modifiers.IsValidIndex(Slot) && SavedMove->Modifiers[Slot].bSent ?
+			SavedMove->Modifiers[Slot].SentModifiers : Registry.Modifiers[Slot]->Modifiers;
+	}
+}
+
 void FModifierNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove,
 	ENetworkMoveType MoveType)
 {
@@ -112,25 +193,42 @@ void FModifierNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Charac
 	
 	const FSavedMove_Character_Modifier& SavedMove = static_cast<const FSavedMove_Character_Modifier&>(ClientMove);
 
-	// Fill the Modifier data from the saved move
-	BoostLocal.ClientFillNetworkMoveData(SavedMove.BoostLocal.WantsModifiers);
-	BoostCorrection.ClientFillNetworkMoveData(SavedMove.BoostCorrection.WantsModifiers, SavedMove.BoostCorrection.Modifiers);
-	BoostServer.ClientFillNetworkMoveData(SavedMove.BoostServer.Modifiers);
-	SnareServer.ClientFillNetworkMoveData(SavedMove.SnareServer.Modifiers);
-	SlowFallLocal.ClientFillNetworkMoveData(SavedMove.SlowFallLocal.WantsModifiers);
+	// Fill the Modifier data from the saved move, the saved move only holds the stacks its net type requires
+	Modifiers.SetNum(SavedMove.Modifiers.Num());
+	for (int32 Slot = 0; Slot < SavedMove.Modifiers.Num(); Slot++)
+	{
+		Modifiers[Slot].ClientFillNetworkMoveData(SavedMove.Modifiers[Slot].WantsModifiers, SavedMove.Modifiers[Slot].MarkSent());
+		Modifiers[Slot].StartWantsModifiers = SavedMove.Modifiers[Slot].StartWantsModifiers;
+	}
+
+	bHasWantsChange = SavedMove.bHasWantsChange;
+	WantsChangeAlpha = SavedMove.WantsChangeAlpha;
 }
 
 bool FModifierNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
 	UPackageMap* PackageMap, ENetworkMoveType MoveType)
 {  // Client ➜ Server
-	Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType);
+	if (!Super::Serialize(CharacterMovement, Ar, PackageMap, MoveType))
+	{
+		return false;
+	}
+
+	// Serialize the point within a combined move that the wanted stacks changed at
+	Ar.SerializeBits(&bHasWantsChange, 1);
+	if (bHasWantsChange)
+	{
+		Ar << WantsChangeAlpha;
+	}
 
 	// Serialize Modifier data
-	BoostLocal.Serialize(Ar, TEXT("BoostLocal"));
-	BoostCorrection.Serialize(Ar, TEXT("BoostCorrection"));
-	BoostServer.Serialize(Ar, TEXT("BoostServer"));
-	SnareServer.Serialize(Ar, TEXT("SnareServer"));
-	SlowFallLocal.Serialize(Ar, TEXT("SlowFallLocal"));
+	const UModifierMovement& MoveComp = static_cast<const UModifierMovement&>(CharacterMovement);
+	if (!MoveComp.GetModifierRegistry().NetSerializeMoveData(Modifiers, Ar, bHasWantsChange,
+		Baseline && MoveType != ENetworkMoveType::NewMove ? &Baseline->Modifiers : nullptr))
+	{
+		// Later moves in the packet are read from where this one stopped, so the whole packet is bad
+		Ar.SetError();
+		return false;
+	}
 
 	return !Ar.IsError();
 }
@@ -147,6 +245,33 @@ void UModifierMovement::PostLoad()
 	ModifierCharacterOwner = Cast<AModifierCharacter>(PawnOwner);
 }
 
+void UModifierMovement::OnRegister()
+{
+	Super::OnRegister();
+
+	// Only needed at runtime, editor previews never apply modifiers
+	const UWorld* World = GetWorld();
+	if (World && World->IsGameWorld())
+	{
+		BakeModifierLevels();
+		ModifierRegistry.InitNetLimits();
+
+		if (GetOwnerRole() == ROLE_Authority)
+		{
+			ModifierHistory.Init(ModifierHistorySize);
+		}
+	}
+}
+
+void UModifierMovement::TickComponent(float DeltaTime, enum ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Moves received from the client this frame were performed before the tick, so this also dispatches theirs
+	DispatchModifierEvents();
+}
+
 void UModifierMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
 {
 	Super::SetUpdatedComponent(NewUpdatedComponent);
@@ -154,36 +279,185 @@ void UModifierMovement::SetUpdatedComponent(USceneComponent* NewUpdatedComponent
 	ModifierCharacterOwner = Cast<AModifierCharacter>(PawnOwner);
 }
 
+const UModifierMovementConfig* UModifierMovement::GetModifierConfig() const
+{
+	if (OwnedModifierConfig)
+	{
+		return OwnedModifierConfig;
+	}
+	return ModifierConfig ? ModifierConfig.Get() : GetDefault<UModifierMovementConfig>();
+}
+
+UModifierMovementConfig* UModifierMovement::GetMutableModifierConfig()
+{
+	if (!OwnedModifierConfig)
+	{
+		// Copy on write, the shared config and the tables other components point at are never modified
+		if (ModifierConfig)
+		{
+			FObjectDuplicationParameters Params = InitStaticDuplicateObjectParams(ModifierConfig.Get(), this, NAME_None, RF_NoFlags);
+			Params.ApplyFlags = RF_Transient;
+			OwnedModifierConfig = CastChecked<UModifierMovementConfig>(StaticDuplicateObjectEx(Params));
+		}
+		else
+		{
+			OwnedModifierConfig = NewObject<UModifierMovementConfig>(this, NAME_None, RF_Transient);
+		}
+	}
+	return OwnedModifierConfig;
+}
+
+void UModifierMovement::BakeModifierLevels()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::BakeModifierLevels);
+
+	// Shared configs are baked when loaded, only our own copy can have changed since
+	if (OwnedModifierConfig)
+	{
+		OwnedModifierConfig->BakeLevelTables();
+	}
+
+	const UModifierMovementConfig* Config = GetModifierConfig();
+	BoostLevelTable = Config->BoostLevelTable;
+	SnareLevelTable = Config->SnareLevelTable;
+	SlowFallLevelTable = Config->SlowFallLevelTable;
+
+	// Agents keep the config they were made with, new ones get a config made from the new tables
+	ModifierAgentConfig.Reset();
+
+	// Max levels may have changed, and the cached params point into the baked tables
+	BindModifierLevelTables();
+	MarkModifiersDirty();
+	UpdateEffectiveModifierParams();
+}
+
+void UModifierMovement::BindModifierLevelTables()
+{
+	auto Bind = [this](const FGameplayTag& ModifierType, const TArray<FGameplayTag>& Levels,
+		const TArray<FMovementModifierParams>* MovementParams, const TArray<FFallingModifierParams>* FallingParams)
+	{
+		const int32 Channel = ModifierRegistry.FindChannel(ModifierType);
+		if (Channel != INDEX_NONE)
+		{
+			FModifierChannelDef& Def = ModifierRegistry.Channels[Channel];
+			Def.LevelTags = &Levels;
+			Def.MovementParams = MovementParams;
+			Def.FallingParams = FallingParams;
+		}
+	};
+
+	Bind(FModifierTags::Modifier_Boost, BoostLevelTable->Levels, &BoostLevelTable->Params, nullptr);
+	Bind(FModifierTags::Modifier_Snare, SnareLevelTable->Levels, &SnareLevelTable->Params, nullptr);
+	Bind(FModifierTags::Modifier_SlowFall, SlowFallLevelTable->Levels, nullptr, &SlowFallLevelTable->Params);
+}
+
+TSharedRef<const FModifierAgentConfig> UModifierMovement::MakeModifierAgentConfig() const
+{
+	const TSharedRef<FModifierAgentConfig> Config = MakeShared<FModifierAgentConfig>();
+
+	FModifierAgentChannel& BoostChannel = Config->Channels.AddDefaulted_GetRef();
+	BoostChannel.ModifierType = FModifierTags::Modifier_Boost;
+	BoostChannel.LevelMethod = BoostLevelMethod;
+	BoostChannel.MaxModifiers = bLimitMaxBoosts ? MaxBoosts : 0;
+	BoostChannel.MovementTable = BoostLevelTable;
+
+	FModifierAgentChannel& SnareChannel = Config->Channels.AddDefaulted_GetRef();
+	SnareChannel.ModifierType = FModifierTags::Modifier_Snare;
+	SnareChannel.LevelMethod = SnareLevelMethod;
+	SnareChannel.MaxModifiers = bLimitMaxSnares ? MaxSnares : 0;
+	SnareChannel.MovementTable = SnareLevelTable;
+
+	FModifierAgentChannel& SlowFallChannel = Config->Channels.AddDefaulted_GetRef();
+	SlowFallChannel.ModifierType = FModifierTags::Modifier_SlowFall;
+	SlowFallChannel.LevelMethod = SlowFallLevelMethod;
+	SlowFallChannel.MaxModifiers = bLimitMaxSlowFalls ? MaxSlowFalls : 0;
+	SlowFallChannel.FallingTable = SlowFallLevelTable;
+
+	return Config;
+}
+
+TSharedRef<const FModifierAgentConfig> UModifierMovement::GetModifierAgentConfig() const
+{
+	if (!ModifierAgentConfig.IsValid())
+	{
+		ModifierAgentConfig = MakeModifierAgentConfig();
+	}
+	return ModifierAgentConfig.ToSharedRef();
+}
+
+void UModifierMovement::UpdateEffectiveModifierParams()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::UpdateEffectiveModifierParams);
+
+	ModifierRegistry.CombineEffectiveParams(EffectiveModifierParams, Velocity);
+}
+
+FGameplayTag UModifierMovement::GetModifierLevelAtServerTime(FGameplayTag ModifierType, double ServerTime, bool& bFound) const
+{
+	bFound = false;
+
+	const int32 Channel = ModifierRegistry.FindChannel(ModifierType);
+	const FModifierHistoryEntry* Entry = Channel != INDEX_NONE ? ModifierHistory.Find(ServerTime) : nullptr;
+	if (!Entry || !Entry->Levels.IsValidIndex(Channel))
+	{
+		return FGameplayTag::EmptyTag;
+	}
+
+	bFound = true;
+	const TArray<FGameplayTag>& LevelTags = *ModifierRegistry.Channels[Channel].LevelTags;
+	const TModSize Level = Entry->Levels[Channel];
+	return LevelTags.IsValidIndex(Level) ? LevelTags[Level] : FGameplayTag::EmptyTag;
+}
+
 float UModifierMovement::GetMaxAcceleration() const
 {
-	return Super::GetMaxAcceleration() * GetBoostAccelScalar() * GetSnareAccelScalar();
+	return Super::GetMaxAcceleration() * GetModifierScalar(EModifierParam::MaxAcceleration);
 }
 
 float UModifierMovement::GetMaxSpeed() const
 {
-	return Super::GetMaxSpeed() * GetBoostSpeedScalar() * GetSnareSpeedScalar();
+	// MaxWalkSpeed scales every mode, the mode specific scalars scale further
+	float Scalar = GetModifierScalar(EModifierParam::MaxWalkSpeed);
+	switch (MovementMode)
+	{
+	case MOVE_Walking:
+	case MOVE_NavWalking:
+		if (IsCrouching())
+		{
+			Scalar *= GetModifierScalar(EModifierParam::MaxWalkSpeedCrouched);
+		}
+		break;
+	case MOVE_Swimming:
+		Scalar *= GetModifierScalar(EModifierParam::MaxSwimSpeed);
+		break;
+	case MOVE_Flying:
+		Scalar *= GetModifierScalar(EModifierParam::MaxFlySpeed);
+		break;
+	default:
+		break;
+	}
+
+	return Super::GetMaxSpeed() * Scalar;
 }
 
 float UModifierMovement::GetMaxBrakingDeceleration() const
 {
-	return Super::GetMaxBrakingDeceleration() * GetBoostBrakingScalar() * GetSnareBrakingScalar();
+	return Super::GetMaxBrakingDeceleration() * GetModifierScalar(EModifierParam::BrakingDeceleration);
 }
 
 float UModifierMovement::GetGroundFriction(float DefaultGroundFriction) const
 {
-	return GroundFriction * GetBoostGroundFrictionScalar() * GetSnareGroundFrictionScalar();
+	return GroundFriction * GetModifierScalar(EModifierParam::GroundFriction);
 }
 
 float UModifierMovement::GetBrakingFriction() const
 {
-	return BrakingFriction * GetBoostBrakingFrictionScalar() * GetSnareBrakingFrictionScalar();
+	return BrakingFriction * GetModifierScalar(EModifierParam::BrakingFriction);
 }
 
 float UModifierMovement::GetRootMotionTranslationScalar() const
 {
-	const float BoostScalar = BoostAffectsRootMotion() ? GetBoostSpeedScalar() : 1.f;
-	const float SnareScalar = SnareAffectsRootMotion() ? GetSnareSpeedScalar() : 1.f;
-	return BoostScalar * SnareScalar;
+	return EffectiveModifierParams.RootMotionTranslationScalar;
 }
 
 float UModifierMovement::GetGravityZ() const
@@ -193,7 +467,9 @@ float UModifierMovement::GetGravityZ() const
 
 FVector UModifierMovement::GetAirControl(float DeltaTime, float TickAirControl, const FVector& FallAcceleration)
 {
-	if (const FFallingModifierParams* SlowFallParams = GetSlowFallParams())
+	TickAirControl *= GetModifierScalar(EModifierParam::AirControl);
+
+	if (const FFallingModifierParams* SlowFallParams = EffectiveModifierParams.Falling)
 	{
 		TickAirControl = SlowFallParams->GetAirControl(TickAirControl);
 	}
@@ -201,6 +477,31 @@ FVector UModifierMovement::GetAirControl(float DeltaTime, float TickAirControl,
 	return Super::GetAirControl(DeltaTime, TickAirControl, FallAcceleration);
 }
 
+FRotator UModifierMovement::GetDeltaRotation(float DeltaTime) const
+{
+	return Super::GetDeltaRotation(DeltaTime) * GetModifierScalar(EModifierParam::RotationRate);
+}
+
+#if UE_5_05_OR_LATER
+bool UModifierMovement::DoJump(bool bReplayingMoves, float DeltaTime)
+#else
+bool UModifierMovement::DoJump(bool bReplayingMoves)
+#endif
+{
+	// JumpZVelocity is read directly by the base implementation, so scale it for the duration of the jump
+	const float BaseJumpZVelocity = JumpZVelocity;
+	JumpZVelocity *= GetModifierScalar(EModifierParam::JumpZVelocity);
+
+#if UE_5_05_OR_LATER
+	const bool bResult = Super::DoJump(bReplayingMoves, DeltaTime);
+#else
+	const bool bResult = Super::DoJump(bReplayingMoves);
+#endif
+
+	JumpZVelocity = BaseJumpZVelocity;
+	return bResult;
+}
+
 void UModifierMovement::CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration)
 {
 	if (IsMovingOnGround())
@@ -243,8 +544,8 @@ bool UModifierMovement::RemoveVelocityZOnSlowFallStart() const
 	}
 	
 	// Optionally clear Z velocity if slow fall is active
-	const EModifierFallZ RemoveVelocityZ = GetSlowFallParams() ?
-		GetSlowFallParams()->RemoveVelocityZOnStart : EModifierFallZ::Disabled;
+	const FFallingModifierParams* SlowFallParams = GetSlowFallParams();
+	const EModifierFallZ RemoveVelocityZ = SlowFallParams ? SlowFallParams->RemoveVelocityZOnStart : EModifierFallZ::Disabled;
 		
 	switch (RemoveVelocityZ)
 	{
@@ -261,6 +562,111 @@ bool UModifierMovement::RemoveVelocityZOnSlowFallStart() const
 	return false;
 }
 
+float UModifierMovement::GetTimestamp() const
+{
+	// Replaying a move on the client, or performing a client's move on the server
+	if (MoveTimestamp >= 0.f)
+	{
+		return MoveTimestamp;
+	}
+
+	if (CharacterOwner->GetLocalRole() == ROLE_Authority)
+	{
+		if (CharacterOwner->IsLocallyControlled())
+		{
+			// Server owned character
+			return GetWorld()->GetTimeSeconds();
+		}
+		else
+		{
+			// Server remote character
+			const FNetworkPredictionData_Server_Character* ServerData = GetPredictionData_Server_Character();
+			return ServerData->CurrentClientTimeStamp;
+		}
+	}
+	else
+	{
+		// Client owned character
+		const FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+		return ClientData->CurrentTimeStamp;
+	}
+}
+
+void UModifierMovement::ProcessModifierTimers()
+{
+	const float Timestamp = GetTimestamp();
+
+	// The client periodically rewinds its timestamp by MinTimeBetweenTimeStampResets, and the server follows it, so
+	// rebase the expiry the same way on both sides -- replayed moves only step back by a fraction of that
+	// Server only characters use the world time, which is never reset
+	if (!IsServerOnlyMovement() && LastTimerTimestamp - Timestamp > MinTimeBetweenTimeStampResets * 0.5f)
+	{
+		for (FMovementModifier* Modifier : ModifierRegistry.Modifiers)
+		{
+			Modifier->RebaseTimers(-MinTimeBetweenTimeStampResets);
+		}
+	}
+	LastTimerTimestamp = Timestamp;
+
+	for (FMovementModifier* Modifier : ModifierRegistry.Modifiers)
+	{
+		if (Modifier->Timers.Num() > 0)
+		{
+			Modifier->ExpireModifiers(Timestamp);
+		}
+		if (Modifier->Schedules.Num() > 0)
+		{
+			Modifier->StartScheduledModifiers(Timestamp);
+		}
+	}
+}
+
+bool UModifierMovement::ScheduleModifier(FMovementModifier& Modifier, TModSize Level, float Duration)
+{
+	if (!CharacterOwner || !CharacterOwner->HasAuthority())
+	{
+		return false;
+	}
+
+	// Server owned characters have no client to wait for
+	if (CharacterOwner->IsLocallyControlled())
+	{
+		return Duration > 0.f ? Modifier.AddTimedModifier(Level, GetTimestamp() + Duration) : Modifier.AddModifier(Level);
+	}
+	
+	FModifierSchedule& Schedule = Modifier.Schedules.AddDefaulted_GetRef();
+	Schedule.Id = ++LastModifierScheduleId;
+	Schedule.Level = Level;
+	Schedule.StartTimestamp = GetTimestamp() + GetScheduledModifierLead();
+	Schedule.Duration = Duration;
+	return true;
+}
+
+float UModifierMovement::GetScheduledModifierLead() const
+{
+	// No client to reach, start on the next move
+	if (IsServerOnlyMovement())
+	{
+		return 0.f;
+	}
+
+	// The client is ahead of the last move we received by roughly half the round trip, and the schedule reaches it
+	// after roughly another half, so it has to start at least one round trip ahead
+	return FMath::Min(GetClientRoundTripTime() * ScheduledModifierLeadScale + ScheduledModifierLeadPadding, MaxScheduledModifierLead);
+}
+
+bool UModifierMovement::IsServerOnlyMovement() const
+{
+	return bUseServerOnlyFastPath && CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_Authority &&
+		CharacterOwner->GetRemoteRole() != ROLE_AutonomousProxy;
+}
+
+float UModifierMovement::GetClientRoundTripTime() const
+{
+	const APlayerState* PlayerState = CharacterOwner ? CharacterOwner->GetPlayerState() : nullptr;
+	return PlayerState ? PlayerState->ExactPing * 0.001f : 0.f;
+}
+
 void UModifierMovement::ProcessModifierMovementState()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::ProcessModifierMovementState);
@@ -268,48 +674,55 @@ void UModifierMovement::ProcessModifierMovementState()
 	// Proxies get replicated Modifier state.
 	if (CharacterOwner->GetLocalRole() != ROLE_SimulatedProxy)
 	{
-		// Check for a change in Modifier state. Players toggle Modifier by changing WantsModifier.
+		// Timers are processed before the channels are evaluated, so the move that reaches them applies them
+		ProcessModifierTimers();
 
-		{	// Boost
-			const FGameplayTag PrevBoostLevel = GetBoostLevel();
-			const uint8 PrevBoostLevelValue = BoostLevel;
-			const TArray<FMovementModifier*> Boosts = { &BoostLocal, &BoostCorrection, &BoostServer };
-			if (FModifierStatics::ProcessModifiers(BoostLevel, BoostLevelMethod, BoostLevels,
-				bLimitMaxBoosts, MaxBoosts, NO_MODIFIER, Boosts,
-				[this] { return CanBoostInCurrentState(); }))
+		// Check for a change in Modifier state. Players toggle Modifier by changing WantsModifier.
+		// Listeners are notified at the end of the tick, see DispatchModifierEvents()
+		for (int32 Channel = 0; Channel < ModifierRegistry.NumChannels(); Channel++)
+		{
+			const TModSize PrevLevel = *ModifierRegistry.Channels[Channel].Level;
+			if (ModifierRegistry.ProcessChannel(Channel))
 			{
-				ModifierCharacterOwner->NotifyModifierChanged<uint8>(FModifierTags::Modifier_Boost,
-					GetBoostLevel(), PrevBoostLevel, BoostLevel,
-					PrevBoostLevelValue, NO_MODIFIER);
+				UpdateEffectiveModifierParams();
+				QueueModifierEvent(Channel, PrevLevel);
 			}
 		}
+	}
+}
 
-		{	// Snare
-			const FGameplayTag PrevSnareLevel = GetSnareLevel();
-			const uint8 PrevSnareLevelValue = SnareLevel;
-			const TArray<FMovementModifier*> Snares = { &SnareServer };
-			if (FModifierStatics::ProcessModifiers(SnareLevel, SnareLevelMethod, SnareLevels,
-				bLimitMaxSnares, MaxSnares, NO_MODIFIER, Snares,
-				[this] { return CanSnareInCurrentState(); }))
-			{
-				ModifierCharacterOwner->NotifyModifierChanged<uint8>(FModifierTags::Modifier_Snare,
-					GetSnareLevel(), PrevSnareLevel, SnareLevel,
-					PrevSnareLevelValue, NO_MODIFIER);
-			}
+void UModifierMovement::QueueModifierEvent(int32 Channel, TModSize PrevLevel)
+{
+	PendingModifierEvents.SetNum(ModifierRegistry.NumChannels());
+
+	// Keep the level from before the first change, so only the net change is dispatched
+	FModifierPendingEvent& Event = PendingModifierEvents[Channel];
+	if (!Event.bPending)
+	{
+		Event.PrevLevel = PrevLevel;
+		Event.bPending = true;
+	}
+}
+
+void UModifierMovement::DispatchModifierEvents()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::DispatchModifierEvents);
+
+	for (int32 Channel = 0; Channel < PendingModifierEvents.Num(); Channel++)
+	{
+		FModifierPendingEvent& Event = PendingModifierEvents[Channel];
+		if (!Event.bPending)
+		{
+			continue;
 		}
+		Event.bPending = false;
 
-		{	// SlowFall
-			const FGameplayTag PrevSlowFallLevel = GetSlowFallLevel();
-			const uint8 PrevSlowFallLevelValue = SlowFallLevel;
-			const TArray<FMovementModifier*> SlowFalls = { &SlowFallLocal };
-			if (FModifierStatics::ProcessModifiers(SlowFallLevel, SlowFallLevelMethod, SlowFallLevels,
-				bLimitMaxSlowFalls, MaxSlowFalls, NO_MODIFIER, SlowFalls,
-				[this] { return CanSlowFallInCurrentState(); }))
-			{
-				ModifierCharacterOwner->NotifyModifierChanged<uint8>(FModifierTags::Modifier_SlowFall,
-					GetSlowFallLevel(), PrevSlowFallLevel, SlowFallLevel,
-					PrevSlowFallLevelValue, NO_MODIFIER);
-			}
+		const TModSize Level = *ModifierRegistry.Channels[Channel].Level;
+		if (Level != Event.PrevLevel && ModifierCharacterOwner)
+		{
+			ModifierCharacterOwner->NotifyModifierChannelChanged(Channel, ModifierRegistry.Channels[Channel].ModifierType,
+				ModifierRegistry.GetLevelTag(Channel), ModifierRegistry.GetLevelTag(Channel, Event.PrevLevel),
+				Level, Event.PrevLevel);
 		}
 	}
 }
@@ -323,15 +736,15 @@ void UModifierMovement::UpdateModifierMovementState()
 		return;
 	}
 
-	// Initialize Modifier levels if empty
-	if (BoostLevels.Num() == 0)	{ for (const auto& Level : Boost) { BoostLevels.Add(Level.Key); } }
-	if (SnareLevels.Num() == 0)	{ for (const auto& Level : Snare) { SnareLevels.Add(Level.Key); } }
-	if (SlowFallLevels.Num() == 0) { for (const auto& Level : SlowFall) { SlowFallLevels.Add(Level.Key); } }
-
 	// Update the modifiers
 	ProcessModifierMovementState();
 }
 
+void UModifierMovement::MarkModifiersDirty()
+{
+	ModifierRegistry.MarkDirty();
+}
+
 void UModifierMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 {
 	if (!HasValidData())
@@ -339,6 +752,13 @@ void UModifierMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 		return;
 	}
 	
+	UpdateModifierStateBeforePhysics();
+	
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+}
+
+void UModifierMovement::UpdateModifierStateBeforePhysics()
+{
 	const bool bWasSlowFalling = IsSlowFallActive();
 	UpdateModifierMovementState();
 
@@ -350,13 +770,22 @@ void UModifierMovement::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
 			Velocity.Z = 0.f;
 		}
 	}
-	
-	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
 }
 
 void UModifierMovement::UpdateCharacterStateAfterMovement(float DeltaSeconds)
 {
-	UpdateModifierMovementState();
+	// Re-evaluated so the levels saved with the move, or checked against the client's, reflect the end of the move
+	// Neither exists for server only characters, whose next move evaluates them before it starts
+	if (!IsServerOnlyMovement())
+	{
+		UpdateModifierMovementState();
+	}
+
+	// Record the state this move ended with for lag compensated queries, on the clock every character shares
+	if (ModifierHistory.Capacity() > 0 && CharacterOwner->GetLocalRole() == ROLE_Authority)
+	{
+		ModifierHistory.Record(GetWorld()->GetTimeSeconds(), ModifierRegistry, EffectiveModifierParams, Velocity);
+	}
 
 	Super::UpdateCharacterStateAfterMovement(DeltaSeconds);
 }
@@ -412,7 +841,8 @@ void UModifierMovement::GrantClientAuthority(FGameplayTag ClientAuthSource, floa
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovement::GrantClientAuthority);
 	
-	if (!CharacterOwner || !CharacterOwner->HasAuthority())
+	// Server only characters never receive a client move to expire or apply authority with
+	if (!CharacterOwner || !CharacterOwner->HasAuthority() || IsServerOnlyMovement())
 	{
 		return;
 	}
@@ -435,7 +865,7 @@ void UModifierMovement::GrantClientAuthority(FGameplayTag ClientAuthSource, floa
 	else
 	{
 #if WITH_EDITOR
-		FMessageLog("PIE").Error(FText::FromString(FString::Printf(TEXT("ClientAuthSource '%s' not found in ClientAuthParams"), *ClientAuthSource.ToString())));
+		FMessageLog("PIE").Error(FText::FromString(FString::Printf(TEXT("ClientAuthSource '%s' not found in the ClientAuthParams of the modifier config"), *ClientAuthSource.ToString())));
 #else
 		UE_LOG(LogModifierMovement, Error, TEXT("ClientAuthSource '%s' not found"), *ClientAuthSource.ToString());
 #endif
@@ -537,12 +967,111 @@ void UModifierMovement::ServerMove_PerformMovement(const FCharacterNetworkMoveDa
 	
 	const FModifierNetworkMoveData& ModifierMoveData = static_cast<const FModifierNetworkMoveData&>(MoveData);
 
-	BoostLocal.ServerMove_PerformMovement(ModifierMoveData.BoostLocal.WantsModifiers);
-	BoostCorrection.ServerMove_PerformMovement(ModifierMoveData.BoostCorrection.WantsModifiers);
-
-	SlowFallLocal.ServerMove_PerformMovement(ModifierMoveData.SlowFallLocal.WantsModifiers);
+	// A combined move starts with the old wanted stacks and switches part way through, same as the client did
+	ClearWantsChange();
+	for (int32 Slot = 0; Slot < ModifierMoveData.Modifiers.Num(); Slot++)
+	{
+		if (ModifierRegistry.HasClientWants(Slot))
+		{
+			const FModifierMoveData_WithCorrection& SlotData = ModifierMoveData.Modifiers[Slot];
+			if (ModifierMoveData.bHasWantsChange)
+			{
+				ModifierRegistry.Modifiers[Slot]->SetWantsModifiers(SlotData.StartWantsModifiers);
+				QueueWantsChange(Slot, SlotData.WantsModifiers, ModifierMoveData.WantsChangeAlpha);
+			}
+			else
+			{
+				ModifierRegistry.Modifiers[Slot]->SetWantsModifiers(SlotData.WantsModifiers);
+			}
+		}
+	}
 
 	Super::ServerMove_PerformMovement(MoveData);
+
+	// The move may have been rejected before it was performed, e.g. a bad timestamp, don't let the change leak into the next
+	ClearWantsChange();
+}
+
+void UModifierMovement::MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+	const FVector& NewAccel)
+{
+	// Server performing a client move, or client replaying a saved move -- expire timed modifiers against this move
+	TGuardValue<float> MoveTimestampGuard(MoveTimestamp, ClientTimeStamp);
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+
+	// A replayed move can return before it is performed
+	ClearWantsChange();
+}
+
+void UModifierMovement::ReplicateMoveToServer(float DeltaTime, const FVector& NewAcceleration)
+{
+	// The change queued by combining moves belongs to this move only
+	Super::ReplicateMoveToServer(DeltaTime, NewAcceleration);
+	ClearWantsChange();
+}
+
+void UModifierMovement::QueueWantsChange(int32 Slot, const TModifierStack& WantsModifiers, uint8 SubMoveAlpha)
+{
+	PendingWantsModifiers.SetNum(ModifierRegistry.NumModifiers());
+	PendingWantsModifiers[Slot] = WantsModifiers;
+	PendingWantsAlpha = SubMoveAlpha;
+	bHasPendingWantsChange = true;
+}
+
+void UModifierMovement::ApplyWantsChange()
+{
+	bHasPendingWantsChange = false;
+	for (int32 Slot = 0; Slot < PendingWantsModifiers.Num(); Slot++)
+	{
+		if (ModifierRegistry.HasClientWants(Slot))
+		{
+			ModifierRegistry.Modifiers[Slot]->SetWantsModifiers(PendingWantsModifiers[Slot]);
+		}
+	}
+	UpdateModifierStateBeforePhysics();
+}
+
+void UModifierMovement::PerformMovement(float DeltaTime)
+{
+	Super::PerformMovement(DeltaTime);
+
+	// Physics didn't run, e.g. no movement mode, the move still ends with the new wanted stacks on every side
+	if (bHasPendingWantsChange && HasValidData())
+	{
+		ApplyWantsChange();
+	}
+}
+
+void UModifierMovement::StartNewPhysics(float deltaTime, int32 Iterations)
+{
+	// Only the move's own physics is split, not the physics restarted by a movement mode change part way through it
+	if (!bHasPendingWantsChange || Iterations > 0)
+	{
+		Super::StartNewPhysics(deltaTime, Iterations);
+		return;
+	}
+
+	// The wanted stacks changed part way through this combined move -- simulate up to the change with the old stacks
+	// then the remainder with the new ones, on the client, the server and during replay alike
+	// Everything else happens once for the whole move, e.g. forces, launches, root motion and the move's events
+	bHasPendingWantsChange = false;
+	const float SubMoveTime = FModifierStatics::GetSubMoveTime(PendingWantsAlpha, deltaTime);
+	if (SubMoveTime > UE_KINDA_SMALL_NUMBER)
+	{
+		Super::StartNewPhysics(SubMoveTime, 0);
+		if (!HasValidData())
+		{
+			return;
+		}
+	}
+
+	ApplyWantsChange();
+
+	const float RemainingTime = deltaTime - SubMoveTime;
+	if (RemainingTime > UE_KINDA_SMALL_NUMBER)
+	{
+		Super::StartNewPhysics(RemainingTime, 0);
+	}
 }
 
 #if UE_5_08_OR_LATER
@@ -558,19 +1087,71 @@ bool UModifierMovement::ServerCheckClientError(float ClientTimeStamp, float Delt
 	// ServerMovePacked_ServerReceive ➜ ServerMove_HandleMoveData ➜ ServerMove_PerformMovement
 	// ➜ ServerMoveHandleClientError ➜ ServerCheckClientError
 	
+	// Record the client's stacks before any early out, a correction sent for this move omits those that still match
+	const FModifierNetworkMoveData* CurrentMoveData = static_cast<const FModifierNetworkMoveData*>(GetCurrentNetworkMoveData());
+	ClientReportedModifiers.SetNum(CurrentMoveData->Modifiers.Num());
+	for (int32 Slot = 0; Slot < CurrentMoveData->Modifiers.Num(); Slot++)
+	{
+		ClientReportedModifiers[Slot] = CurrentMoveData->Modifiers[Slot].Modifiers;
+	}
+	ClientReportedTimestamp = ClientTimeStamp;
+
 	if (Super::ServerCheckClientError(ClientTimeStamp, DeltaTime, Accel, ClientWorldLocation, RelativeClientLocation, ClientMovementBase, ClientBaseBoneName, ClientMovementMode))
 	{
 		return true;
 	}
     
+	// A correction reaches the client roughly a round trip after the move it was sent for
+	const float CorrectionAckTime = GetClientRoundTripTime() * ModifierCorrectionAckScale + ModifierCorrectionAckPadding;
+
 	// Trigger a client correction if the value in the Client differs
-	const FModifierNetworkMoveData* CurrentMoveData = static_cast<const FModifierNetworkMoveData*>(GetCurrentNetworkMoveData());
+	bPendingStateCorrection = false;
+	PendingCorrections.SetNum(ModifierRegistry.NumModifiers());
+	bool bModifierError = false;
+	bool bRequiresFullCorrection = false;
+	for (int32 Slot = 0; Slot < CurrentMoveData->Modifiers.Num(); Slot++)
+	{
+		if (!ModifierRegistry.HasServerCorrection(Slot))
+		{
+			continue;
+		}
 
-	if (BoostCorrection.ServerCheckClientError(CurrentMoveData->BoostCorrection.Modifiers))	{ return true; }
-	if (BoostServer.ServerCheckClientError(CurrentMoveData->BoostServer.Modifiers)) { return true; }
-	if (SnareServer.ServerCheckClientError(CurrentMoveData->SnareServer.Modifiers)) { return true; }
+		const TModifierStack& ServerModifiers = ModifierRegistry.Modifiers[Slot]->Modifiers;
+		FModifierPendingCorrection& PendingCorrection = PendingCorrections[Slot];
+		if (ServerModifiers == CurrentMoveData->Modifiers[Slot].Modifiers)
+		{
+			// The client has applied the correction
+			PendingCorrection.bPending = false;
+		}
+		else if (PendingCorrection.bPending && PendingCorrection.Modifiers == ServerModifiers &&
+			FMath::IsWithin(ClientTimeStamp - PendingCorrection.Timestamp, 0.f, CorrectionAckTime))
+		{
+			// Already sent this stack, the client made this move before receiving it -- if the correction was lost it
+			// is sent again once the wait is over
+			continue;
+		}
+		else
+		{
+			bModifierError = true;
 
-	return false;
+			// The client received this stack with an ack and kept its own, as it predicted a change past the acked move
+			bRequiresFullCorrection |= PendingCorrection.bPending && PendingCorrection.bStateOnly &&
+				PendingCorrection.Modifiers == ServerModifiers;
+		}
+	}
+
+	if (!bModifierError)
+	{
+		return false;
+	}
+
+	// Position agrees, so send the stacks with the ack rather than rewinding the client
+	if (bUseStateOnlyCorrections && !bRequiresFullCorrection)
+	{
+		bPendingStateCorrection = true;
+		return false;
+	}
+	return true;
 }
 
 #if UE_5_08_OR_LATER
@@ -666,27 +1247,162 @@ void UModifierMovement::OnClientCorrectionReceived(class FNetworkPredictionData_
 	
 	const FModifierMoveResponseDataContainer& MoveResponse = static_cast<const FModifierMoveResponseDataContainer&>(GetMoveResponseDataContainer());
 
-	BoostCorrection.OnClientCorrectionReceived(MoveResponse.BoostCorrection.Modifiers);
-	BoostServer.OnClientCorrectionReceived(MoveResponse.BoostServer.Modifiers);
-	SnareServer.OnClientCorrectionReceived(MoveResponse.SnareServer.Modifiers);
+	for (int32 Slot = 0; Slot < MoveResponse.Modifiers.Num(); Slot++)
+	{
+		if (ModifierRegistry.HasServerCorrection(Slot))
+		{
+			ModifierRegistry.Modifiers[Slot]->SetWantsModifiers(MoveResponse.Modifiers[Slot].Modifiers);
+		}
+		if (ModifierRegistry.HasServerTimers(Slot))
+		{
+			// The corrected state predates any schedule that hasn't started on the server, so take the server's as-is
+			FMovementModifier* Modifier = ModifierRegistry.Modifiers[Slot];
+			Modifier->SetTimers(MoveResponse.Modifiers[Slot].Timers);
+			Modifier->SetSchedules(MoveResponse.Modifiers[Slot].Schedules, LastModifierScheduleId);
+		}
+	}
+	MarkModifiersDirty();
 
 	Super::OnClientCorrectionReceived(ClientData, TimeStamp, UpdatedComponent->GetComponentLocation(), NewVelocity, NewBase, NewBaseBoneName,
 		bHasBase, bBaseRelativePosition, ServerMovementMode, ServerGravityDirection);
 }
 
+void UModifierMovement::ClientAckGoodMove_Implementation(float TimeStamp)
+{
+	// Receive scheduled modifiers piggy-backed on the ack
+	const FModifierMoveResponseDataContainer& MoveResponse = static_cast<const FModifierMoveResponseDataContainer&>(GetMoveResponseDataContainer());
+	for (int32 Slot = 0; Slot < MoveResponse.Modifiers.Num(); Slot++)
+	{
+		if (ModifierRegistry.HasServerTimers(Slot))
+		{
+			ModifierRegistry.Modifiers[Slot]->ReceiveSchedules(MoveResponse.Modifiers[Slot].Schedules, LastModifierScheduleId);
+		}
+	}
+
+	if (MoveResponse.bHasStateCorrection)
+	{
+		OnClientStateCorrectionReceived(TimeStamp, MoveResponse);
+	}
+
+	Super::ClientAckGoodMove_Implementation(TimeStamp);
+}
+
+void UModifierMovement::ServerSendMoveResponse(const FClientAdjustment& PendingAdjustment)
+{
+	// Record the stacks sent, so moves the client makes before applying them aren't corrected again
+	if (!PendingAdjustment.bAckGoodMove || bPendingStateCorrection)
+	{
+		PendingCorrections.SetNum(ModifierRegistry.NumModifiers());
+		for (int32 Slot = 0; Slot < ModifierRegistry.NumModifiers(); Slot++)
+		{
+			if (ModifierRegistry.HasServerCorrection(Slot))
+			{
+				FModifierPendingCorrection& PendingCorrection = PendingCorrections[Slot];
+				PendingCorrection.Modifiers = ModifierRegistry.Modifiers[Slot]->Modifiers;
+				PendingCorrection.Timestamp = PendingAdjustment.TimeStamp;
+				PendingCorrection.bPending = true;
+				PendingCorrection.bStateOnly = PendingAdjustment.bAckGoodMove;
+			}
+		}
+	}
+
+	Super::ServerSendMoveResponse(PendingAdjustment);
+
+	// Sent
+	bPendingStateCorrection = false;
+}
+
+void UModifierMovement::OnClientStateCorrectionReceived(float TimeStamp,
+	const FModifierMoveResponseDataContainer& MoveResponse)
+{
+	FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+	const int32 AckedIndex = ClientData->GetSavedMoveIndex(TimeStamp);
+	const FSavedMove_Character_Modifier* AckedMove = AckedIndex != INDEX_NONE ?
+		static_cast<const FSavedMove_Character_Modifier*>(ClientData->SavedMoves[AckedIndex].Get()) : nullptr;
+
+	for (int32 Slot = 0; Slot < MoveResponse.Modifiers.Num(); Slot++)
+	{
+		if (!ModifierRegistry.HasServerCorrection(Slot))
+		{
+			continue;
+		}
+
+		// Without the acked move there is no telling stale state from state predicted since, leave it to the server
+		if (!AckedMove || !AckedMove->Modifiers.IsValidIndex(Slot))
+		{
+			continue;
+		}
+
+		const TModifierStack& ServerModifiers = MoveResponse.Modifiers[Slot].Modifiers;
+		const FModifierSavedMove_WithCorrection& StaleSlot = AckedMove->Modifiers[Slot];
+		const bool bHasClientWants = ModifierRegistry.HasClientWants(Slot);
+		auto IsStale = [&StaleSlot, bHasClientWants](const TModifierStack& InModifiers, const TModifierStack& InWantsModifiers)
+		{
+			return InModifiers == StaleSlot.Modifiers && (!bHasClientWants || InWantsModifiers == StaleSlot.WantsModifiers);
+		};
+
+		// Moves made since the acked move recorded the same stale stack, and would otherwise be flagged again -- up to
+		// the first move the client changed the stack on, which the server hasn't seen yet
+		bool bDiverged = false;
+		for (int32 Index = AckedIndex + 1; Index < ClientData->SavedMoves.Num() && !bDiverged; Index++)
+		{
+			FSavedMove_Character_Modifier* SavedMove = static_cast<FSavedMove_Character_Modifier*>(ClientData->SavedMoves[Index].Get());
+			if (!SavedMove->Modifiers.IsValidIndex(Slot))
+			{
+				continue;
+			}
+
+			FModifierSavedMove_WithCorrection& SavedSlot = SavedMove->Modifiers[Slot];
+			bDiverged = !IsStale(SavedSlot.Modifiers, SavedSlot.WantsModifiers);
+			if (!bDiverged)
+			{
+				SavedSlot.Modifiers = ServerModifiers;
+			}
+		}
+
+		// The client predicted a change since, applying the server's older stack would drop it
+		FMovementModifier* Modifier = ModifierRegistry.Modifiers[Slot];
+		if (bDiverged || !IsStale(Modifier->Modifiers, Modifier->WantsModifiers))
+		{
+			continue;
+		}
+
+		// Same as a correction, see OnClientCorrectionReceived()
+		Modifier->SetWantsModifiers(ServerModifiers);
+		if (ModifierRegistry.HasServerTimers(Slot))
+		{
+			Modifier->SetTimers(MoveResponse.Modifiers[Slot].Timers);
+			Modifier->SetSchedules(MoveResponse.Modifiers[Slot].Schedules, LastModifierScheduleId);
+		}
+	}
+	MarkModifiersDirty();
+}
+
 bool UModifierMovement::ClientUpdatePositionAfterServerUpdate()
 {
-	const TModifierStack RealBoostLocal = BoostLocal.WantsModifiers;
-	const TModifierStack RealBoostCorrection = BoostCorrection.WantsModifiers;
-	const TModifierStack RealSlowFallLocal = SlowFallLocal.WantsModifiers;
+	// Replaying moves overwrites the client driven wanted stacks, restore them afterward
+	TModifierSlotArray<TModifierStack> RealWantsModifiers;
+	RealWantsModifiers.SetNum(ModifierRegistry.NumModifiers());
+	for (int32 Slot = 0; Slot < ModifierRegistry.NumModifiers(); Slot++)
+	{
+		if (ModifierRegistry.HasClientWants(Slot))
+		{
+			RealWantsModifiers[Slot] = ModifierRegistry.Modifiers[Slot]->WantsModifiers;
+		}
+	}
 
 	const FVector ClientLoc = UpdatedComponent->GetComponentLocation();
 	
 	const bool bResult = Super::ClientUpdatePositionAfterServerUpdate();
 	
-	BoostLocal.WantsModifiers = RealBoostLocal;
-	BoostCorrection.WantsModifiers = RealBoostCorrection;
-	SlowFallLocal.WantsModifiers = RealSlowFallLocal;
+	for (int32 Slot = 0; Slot < ModifierRegistry.NumModifiers(); Slot++)
+	{
+		if (ModifierRegistry.HasClientWants(Slot))
+		{
+			ModifierRegistry.Modifiers[Slot]->SetWantsModifiers(RealWantsModifiers[Slot]);
+		}
+	}
+	MarkModifiersDirty();
 
 	// Preserve client location relative to the partial client authority we have
 	const FVector AuthLocation = FMath::Lerp<FVector>(UpdatedComponent->GetComponentLocation(), ClientLoc, ClientAuthAlpha);
@@ -757,15 +1473,11 @@ void FSavedMove_Character_Modifier::Clear()
 {
 	Super::Clear();
 
-	BoostLocal.Clear();
-	BoostCorrection.Clear();
-	BoostServer.Clear();
-	SnareServer.Clear();
-	SlowFallLocal.Clear();
-
-	BoostLevel = NO_MODIFIER;
-	SnareLevel = NO_MODIFIER;
-	SlowFallLevel = NO_MODIFIER;
+	// Reset rather than Empty, to keep the inline storage
+	Modifiers.Reset();
+	Levels.Reset();
+	bHasWantsChange = false;
+	WantsChangeAlpha = 0;
 }
 
 void FSavedMove_Character_Modifier::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel,
@@ -777,9 +1489,15 @@ void FSavedMove_Character_Modifier::SetMoveFor(ACharacter* C, float InDeltaTime,
 
 	if (const UModifierMovement* MoveComp = Cast<AModifierCharacter>(C)->GetModifierCharacterMovement())
 	{
-		BoostLocal.SetMoveFor(MoveComp->BoostLocal.WantsModifiers);
-		BoostCorrection.SetMoveFor(MoveComp->BoostCorrection.WantsModifiers);
-		SlowFallLocal.SetMoveFor(MoveComp->SlowFallLocal.WantsModifiers);
+		const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
+		Modifiers.SetNum(Registry.NumModifiers());
+		for (int32 Slot = 0; Slot < Registry.NumModifiers(); Slot++)
+		{
+			if (Registry.HasClientWants(Slot))
+			{
+				Modifiers[Slot].SetMoveFor(Registry.Modifiers[Slot]->WantsModifiers);
+			}
+		}
 	}
 }
 
@@ -805,15 +1523,19 @@ bool FSavedMove_Character_Modifier::CanCombineWith(const FSavedMovePtr& NewMove,
 	// We can only combine moves if they will result in the same state as if both moves were processed individually,
 	// because the AutonomousProxy Client processes them individually prior to sending them to the server.
 
-	if (!BoostLocal.CanCombineWith(SavedMove->BoostLocal.WantsModifiers)) { return false; }
-	if (!BoostCorrection.CanCombineWith(SavedMove->BoostCorrection.WantsModifiers)) { return false; }
-
-	if (!SlowFallLocal.CanCombineWith(SavedMove->SlowFallLocal.WantsModifiers)) { return false; }
+	// Only the wanted stacks of client driven modifiers are saved, so this compares exactly those
+	// They may differ, the combined move then switches stacks part way through (see CombineWith()), but only once
+	if (Modifiers.Num() != SavedMove->Modifiers.Num()) { return false; }
+	if (bHasWantsChange)
+	{
+		for (int32 Slot = 0; Slot < Modifiers.Num(); Slot++)
+		{
+			if (!Modifiers[Slot].CanCombineWith(SavedMove->Modifiers[Slot].WantsModifiers)) { return false; }
+		}
+	}
 
 	// Without these, the change/start/stop events will trigger twice causing de-sync, so we don't combine moves if the level changes
-	if (BoostLevel != SavedMove->BoostLevel) { return false; }
-	if (SnareLevel != SavedMove->SnareLevel) { return false; }
-	if (SlowFallLevel != SavedMove->SlowFallLevel) { return false; }
+	if (Levels != SavedMove->Levels) { return false; }
 	
 	return FSavedMove_Character::CanCombineWith(NewMove, InCharacter, MaxDelta);
 }
@@ -828,13 +1550,21 @@ void FSavedMove_Character_Modifier::SetInitialPosition(ACharacter* C)
 	// Retrieve the value from our CMC to revert the saved move value back to this.
 	if (const UModifierMovement* MoveComp = Cast<AModifierCharacter>(C)->GetModifierCharacterMovement())
 	{
-		BoostLocal.SetInitialPosition(MoveComp->BoostLocal.WantsModifiers);
-		BoostCorrection.SetInitialPosition(MoveComp->BoostCorrection.WantsModifiers);
-		SlowFallLocal.SetInitialPosition(MoveComp->SlowFallLocal.WantsModifiers);
+		const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
+		Modifiers.SetNum(Registry.NumModifiers());
+		for (int32 Slot = 0; Slot < Registry.NumModifiers(); Slot++)
+		{
+			if (Registry.HasClientWants(Slot))
+			{
+				Modifiers[Slot].SetInitialPosition(Registry.Modifiers[Slot]->WantsModifiers);
+			}
+		}
 
-		BoostLevel = MoveComp->BoostLevel;
-		SnareLevel = MoveComp->SnareLevel;
-		SlowFallLevel = MoveComp->SlowFallLevel;
+		Levels.SetNumUninitialized(Registry.NumChannels());
+		for (int32 Channel = 0; Channel < Registry.NumChannels(); Channel++)
+		{
+			Levels[Channel] = *Registry.Channels[Channel].Level;
+		}
 	}
 }
 
@@ -847,13 +1577,44 @@ void FSavedMove_Character_Modifier::CombineWith(const FSavedMove_Character* OldM
 
 	if (UModifierMovement* MoveComp = C ? Cast<UModifierMovement>(C->GetCharacterMovement()) : nullptr)
 	{
-		MoveComp->BoostLocal.CombineWith(SavedOldMove->BoostLocal.WantsModifiers);
-		MoveComp->BoostCorrection.CombineWith(SavedOldMove->BoostCorrection.WantsModifiers);
-		MoveComp->SlowFallLocal.CombineWith(SavedOldMove->SlowFallLocal.WantsModifiers);
+		const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
+
+		// The combined move starts with the old move's wanted stacks, and switches to ours at the point they changed
+		// which is where the old move ended, unless it already contained a change -- DeltaTime is now combined
+		const float SubMoveTime = SavedOldMove->bHasWantsChange ?
+			FModifierStatics::GetSubMoveTime(SavedOldMove->WantsChangeAlpha, SavedOldMove->DeltaTime) : SavedOldMove->DeltaTime;
+		
+		bHasWantsChange = false;
+		for (int32 Slot = 0; Slot < SavedOldMove->Modifiers.Num(); Slot++)
+		{
+			if (Registry.HasClientWants(Slot))
+			{
+				const FModifierSavedMove_WithCorrection& OldSlot = SavedOldMove->Modifiers[Slot];
+				Modifiers[Slot].StartWantsModifiers = SavedOldMove->bHasWantsChange ? OldSlot.StartWantsModifiers : OldSlot.WantsModifiers;
+				bHasWantsChange |= Modifiers[Slot].StartWantsModifiers != Modifiers[Slot].WantsModifiers;
+			}
+		}
+		WantsChangeAlpha = bHasWantsChange ? FModifierStatics::QuantizeSubMoveAlpha(SubMoveTime, DeltaTime) : 0;
 
-		MoveComp->BoostLevel = SavedOldMove->BoostLevel;
-		MoveComp->SnareLevel = SavedOldMove->SnareLevel;
-		MoveComp->SlowFallLevel = SavedOldMove->SlowFallLevel;
+		MoveComp->ClearWantsChange();
+		for (int32 Slot = 0; Slot < SavedOldMove->Modifiers.Num(); Slot++)
+		{
+			if (Registry.HasClientWants(Slot))
+			{
+				Registry.Modifiers[Slot]->SetWantsModifiers(Modifiers[Slot].StartWantsModifiers);
+				if (bHasWantsChange)
+				{
+					MoveComp->QueueWantsChange(Slot, Modifiers[Slot].WantsModifiers, WantsChangeAlpha);
+				}
+			}
+		}
+
+		for (int32 Channel = 0; Channel < SavedOldMove->Levels.Num(); Channel++)
+		{
+			*Registry.Channels[Channel].Level = SavedOldMove->Levels[Channel];
+		}
+		MoveComp->MarkModifiersDirty();
+		MoveComp->UpdateEffectiveModifierParams();
 	}
 }
 
@@ -862,9 +1623,15 @@ void FSavedMove_Character_Modifier::PostUpdate(ACharacter* C, EPostUpdateMode Po
 	// When considering whether to delay or combine moves, we need to compare the move at the start and the end
 	if (const UModifierMovement* MoveComp = C ? Cast<UModifierMovement>(C->GetCharacterMovement()) : nullptr)
 	{
-		BoostCorrection.PostUpdate(MoveComp->BoostCorrection.Modifiers);
-		BoostServer.PostUpdate(MoveComp->BoostServer.Modifiers);
-		SnareServer.PostUpdate(MoveComp->SnareServer.Modifiers);
+		const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
+		Modifiers.SetNum(Registry.NumModifiers());
+		for (int32 Slot = 0; Slot < Registry.NumModifiers(); Slot++)
+		{
+			if (Registry.HasServerCorrection(Slot))
+			{
+				Modifiers[Slot].PostUpdate(Registry.Modifiers[Slot]->Modifiers);
+			}
+		}
 
 		// if (PostUpdateMode == PostUpdate_Record)
 	}
@@ -872,15 +1639,44 @@ void FSavedMove_Character_Modifier::PostUpdate(ACharacter* C, EPostUpdateMode Po
 	Super::PostUpdate(C, PostUpdateMode);
 }
 
+void FSavedMove_Character_Modifier::PrepMoveFor(ACharacter* C)
+{
+	Super::PrepMoveFor(C);
+
+	// Replay the move with the wanted stacks it was made with, including a change part way through
+	if (UModifierMovement* MoveComp = C ? Cast<UModifierMovement>(C->GetCharacterMovement()) : nullptr)
+	{
+		const FModifierRegistry& Registry = MoveComp->GetModifierRegistry();
+		MoveComp->ClearWantsChange();
+		for (int32 Slot = 0; Slot < Modifiers.Num(); Slot++)
+		{
+			if (Registry.HasClientWants(Slot))
+			{
+				if (bHasWantsChange)
+				{
+					Registry.Modifiers[Slot]->SetWantsModifiers(Modifiers[Slot].StartWantsModifiers);
+					MoveComp->QueueWantsChange(Slot, Modifiers[Slot].WantsModifiers, WantsChangeAlpha);
+				}
+				else
+				{
+					Registry.Modifiers[Slot]->SetWantsModifiers(Modifiers[Slot].WantsModifiers);
+				}
+			}
+		}
+	}
+}
+
 bool FSavedMove_Character_Modifier::IsImportantMove(const FSavedMovePtr& LastAckedMove) const
 {
 	// Important moves get sent again if not acked by the server
 	
 	const TSharedPtr<FSavedMove_Character_Modifier>& SavedMove = StaticCastSharedPtr<FSavedMove_Character_Modifier>(LastAckedMove);
 
-	if (BoostLocal.IsImportantMove(SavedMove->BoostLocal.WantsModifiers)) { return true; }
-	if (BoostCorrection.IsImportantMove(SavedMove->BoostCorrection.WantsModifiers))	{ return true; }
-	if (SlowFallLocal.IsImportantMove(SavedMove->SlowFallLocal.WantsModifiers)) { return true; }
+	if (Modifiers.Num() != SavedMove->Modifiers.Num()) { return true; }
+	for (int32 Slot = 0; Slot < Modifiers.Num(); Slot++)
+	{
+		if (Modifiers[Slot].IsImportantMove(SavedMove->Modifiers[Slot].WantsModifiers)) { return true; }
+	}
 	
 	return Super::IsImportantMove(LastAckedMove);
 }
@@ -0,0 +1,83 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierMovementConfig.h"
+
+#include "Modifier/ModifierTags.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(ModifierMovementConfig)
+
+namespace ModifierMovementConfigPrivate
+{
+	template<typename T>
+	void BakeLevelTable(TSharedRef<const TModifierLevelTable<T>>& Table, const TMap<FGameplayTag, T>& Params,
+		const TArray<FGameplayTag>& Levels)
+	{
+		const TSharedRef<TModifierLevelTable<T>> NewTable = MakeShared<TModifierLevelTable<T>>();
+		FModifierStatics::BakeModifierLevels(Params, Levels, *NewTable);
+
+		// Curves are sampled per physics iteration, bake them so that is a table lookup
+		if constexpr (std::is_same_v<T, FFallingModifierParams>)
+		{
+			for (FFallingModifierParams& LevelParams : NewTable->Params)
+			{
+				LevelParams.BakeCurves();
+			}
+		}
+		Table = NewTable;
+	}
+}
+
+UModifierMovementConfig::UModifierMovementConfig(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// Init Modifier Levels
+	Boost.Add(FModifierTags::Modifier_Boost, { 1.50f });  // 50% Speed Boost
+	Snare.Add(FModifierTags::Modifier_Snare, { 0.50f });  // 50% Speed Snare
+	SlowFall.Add(FModifierTags::Modifier_SlowFall, { 0.1f });  // 90% Gravity Reduction
+
+	// Auth params for Snare
+	static constexpr int32 DefaultPriority = 5;
+	ClientAuthParams.FindOrAdd(FModifierTags::ClientAuth_Snare, { DefaultPriority });
+}
+
+void UModifierMovementConfig::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// The class defaults are used by every component without a config, loaded configs bake again in PostLoad()
+	BakeLevelTables();
+}
+
+void UModifierMovementConfig::PostLoad()
+{
+	Super::PostLoad();
+
+	BakeLevelTables();
+}
+
+#if WITH_EDITOR
+void UModifierMovementConfig::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeLevelTables();
+}
+#endif
+
+void UModifierMovementConfig::BakeLevelTables()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UModifierMovementConfig::BakeLevelTables);
+
+	ModifierMovementConfigPrivate::BakeLevelTable(BoostLevelTable, Boost, BoostLevels);
+	ModifierMovementConfigPrivate::BakeLevelTable(SnareLevelTable, Snare, SnareLevels);
+	ModifierMovementConfigPrivate::BakeLevelTable(SlowFallLevelTable, SlowFall, SlowFallLevels);
+}
+
+SIZE_T UModifierMovementConfig::GetParamsAllocatedSize() const
+{
+	return Boost.GetAllocatedSize() + BoostLevels.GetAllocatedSize()
+		+ Snare.GetAllocatedSize() + SnareLevels.GetAllocatedSize()
+		+ SlowFall.GetAllocatedSize() + SlowFallLevels.GetAllocatedSize()
+		+ ClientAuthParams.GetAllocatedSize();
+}
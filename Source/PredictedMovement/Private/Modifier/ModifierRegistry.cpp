@@ -0,0 +1,349 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Modifier/ModifierRegistry.h"
+
+namespace ModifierRegistryPrivate
+{
+	/**
+	 * Serialize a stack that usually matches the baseline or is empty, e.g. a wanted stack, each costing a single bit
+	 * Otherwise it costs those bits plus the stack
+	 */
+	bool NetSerializeDelta(const FModifierRegistry& Registry, int32 Slot, TModifierStack& Stack,
+		const TModifierStack* Baseline, FArchive& Ar)
+	{
+		if (Baseline)
+		{
+			bool bMatchesBaseline = Ar.IsSaving() && Stack == *Baseline;
+			Ar.SerializeBits(&bMatchesBaseline, 1);
+			if (bMatchesBaseline)
+			{
+				if (Ar.IsLoading())
+				{
+					Stack = *Baseline;
+				}
+				return true;
+			}
+		}
+
+		bool bHasModifiers = Ar.IsSaving() && Stack.Num() > 0;
+		Ar.SerializeBits(&bHasModifiers, 1);
+		if (!bHasModifiers)
+		{
+			if (Ar.IsLoading())
+			{
+				Stack.Reset();
+			}
+			return true;
+		}
+
+		return Registry.NetSerializeStack(Slot, Stack, Ar);
+	}
+}
+
+
+int32 FModifierRegistry::AddChannel(FModifierChannelDef&& Channel)
+{
+	check(Channel.Level && Channel.LevelTags && Channel.bLimitMaxModifiers && Channel.MaxModifiers);
+	check(Channel.LevelMethod || Channel.ProcessLevels);
+
+	BindLevelPolicy(Channel);
+
+	FirstModifiers.Add(Modifiers.Num());
+	NumChannelModifiers.Add(0);
+	DirtyStates.AddDefaulted();
+	return Channels.Add(MoveTemp(Channel));
+}
+
+int32 FModifierRegistry::AddModifier(int32 Channel, FMovementModifier& Modifier, EModifierNetType NetType,
+	const FString& Name)
+{
+	// Modifiers of a channel must be contiguous
+	check(Channel == Channels.Num() - 1);
+
+	NumChannelModifiers[Channel]++;
+	NetTypes.Add(NetType);
+	ModifierChannels.Add(Channel);
+	Names.Add(Name);
+	return Modifiers.Add(&Modifier);
+}
+
+bool FModifierRegistry::ProcessChannel(int32 Channel)
+{
+	FModifierChannelDef& Def = Channels[Channel];
+	const TArrayView<FMovementModifier* const> ChannelModifiers = GetChannelModifiers(Channel);
+
+	// The level method was changed since it was bound, e.g. from Blueprint, so the level must be evaluated again
+	FModifierChannelDirtyState& DirtyState = DirtyStates[Channel];
+	if (Def.LevelMethod && *Def.LevelMethod != Def.BoundLevelMethod)
+	{
+		BindLevelPolicy(Def);
+		DirtyState.MarkDirty();
+	}
+
+	if (!FModifierStatics::UpdateDirtyState(DirtyState, ChannelModifiers,
+		Def.CanActivate ? TFunctionRef<bool()>(Def.CanActivate) : TFunctionRef<bool()>([] { return true; })))
+	{
+		return false;
+	}
+
+	if (Def.ProcessLevels)
+	{
+		return Def.ProcessLevels(*Def.Level, *Def.LevelTags, *Def.bLimitMaxModifiers, *Def.MaxModifiers, NO_MODIFIER,
+			ChannelModifiers, DirtyState.bCanActivate);
+	}
+
+	// Only a level method without a policy gets here, which the runtime dispatch handles
+	return FModifierStatics::ProcessModifierLevels(*Def.Level, *Def.LevelMethod, *Def.LevelTags, *Def.bLimitMaxModifiers,
+		*Def.MaxModifiers, NO_MODIFIER, ChannelModifiers, DirtyState.bCanActivate);
+}
+
+void FModifierRegistry::BindLevelPolicy(FModifierChannelDef& Channel)
+{
+	if (!Channel.LevelMethod)
+	{
+		return;
+	}
+
+	Channel.BoundLevelMethod = *Channel.LevelMethod;
+	switch (Channel.BoundLevelMethod)
+	{
+	case EModifierLevelMethod::Max:
+		Channel.ProcessLevels = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Max>;
+		break;
+	case EModifierLevelMethod::Min:
+		Channel.ProcessLevels = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Min>;
+		break;
+	case EModifierLevelMethod::Stack:
+		Channel.ProcessLevels = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Stack>;
+		break;
+	case EModifierLevelMethod::Average:
+		Channel.ProcessLevels = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Average>;
+		break;
+	default:
+		Channel.ProcessLevels = nullptr;
+		break;
+	}
+}
+
+void FModifierRegistry::InitNetLimits()
+{
+	if (bNetLimitsInitialized)
+	{
+		return;
+	}
+	bNetLimitsInitialized = true;
+
+	for (FModifierChannelDef& Def : Channels)
+	{
+		// Unlimited channels can hold any number of modifiers, up to what TModSize can count
+		Def.NetNumLevels = Def.LevelTags->Num();
+		Def.NetMaxModifiers = *Def.bLimitMaxModifiers ? *Def.MaxModifiers : NO_MODIFIER - 1;
+	}
+
+	// Wanted stacks hold no more than is sent, so both sides drop the same entries when they are spammed
+	for (int32 Slot = 0; Slot < Modifiers.Num(); Slot++)
+	{
+		Modifiers[Slot]->MaxWantsModifiers = Channels[ModifierChannels[Slot]].NetMaxModifiers;
+	}
+}
+
+bool FModifierRegistry::NetSerializeStack(int32 Slot, TModifierStack& Stack, FArchive& Ar) const
+{
+	const FModifierChannelDef& Def = Channels[ModifierChannels[Slot]];
+	return FModifierStatics::NetSerializePacked(Stack, Ar, Names[Slot], Def.NetNumLevels, Def.NetMaxModifiers);
+}
+
+bool FModifierRegistry::NetSerializeMoveData(TModifierSlotArray<FModifierMoveData_WithCorrection>& MoveData,
+	FArchive& Ar, bool bHasWantsChange, const TModifierSlotArray<FModifierMoveData_WithCorrection>* Baseline) const
+{
+	using namespace ModifierRegistryPrivate;
+
+	if (Ar.IsLoading())
+	{
+		MoveData.SetNum(NumModifiers());
+	}
+
+	// The baseline was serialized earlier in the same packet, so both sides hold the same stacks for it
+	static const FModifierMoveData_WithCorrection EmptyData;
+
+	for (int32 Slot = 0; Slot < NumModifiers(); Slot++)
+	{
+		FModifierMoveData_WithCorrection& Data = MoveData[Slot];
+		const FModifierMoveData_WithCorrection* BaselineData = !Baseline ? nullptr :
+			Baseline->IsValidIndex(Slot) ? &(*Baseline)[Slot] : &EmptyData;
+		if (HasClientWants(Slot) && !NetSerializeDelta(*this, Slot, Data.WantsModifiers,
+			BaselineData ? &BaselineData->WantsModifiers : nullptr, Ar))
+		{
+			return false;
+		}
+		if (bHasWantsChange && HasClientWants(Slot) && !NetSerializeDelta(*this, Slot, Data.StartWantsModifiers,
+			BaselineData ? &BaselineData->WantsModifiers : nullptr, Ar))
+		{
+			return false;
+		}
+		if (HasServerCorrection(Slot) && !NetSerializeDelta(*this, Slot, Data.Modifiers,
+			BaselineData ? &BaselineData->Modifiers : nullptr, Ar))
+		{
+			return false;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+bool FModifierRegistry::NetSerializeMoveResponse(TModifierSlotArray<FModifierMoveResponse>& Response,
+	FArchive& Ar) const
+{
+	if (Ar.IsLoading())
+	{
+		Response.SetNum(NumModifiers());
+	}
+
+	for (int32 Slot = 0; Slot < NumModifiers(); Slot++)
+	{
+		if (HasServerCorrection(Slot))
+		{
+			FModifierMoveResponse& SlotResponse = Response[Slot];
+			Ar.SerializeBits(&SlotResponse.bMatchesClient, 1);
+			if (!SlotResponse.bMatchesClient && !NetSerializeStack(Slot, SlotResponse.Modifiers, Ar))
+			{
+				return false;
+			}
+		}
+		if (HasServerTimers(Slot) && !FModifierStatics::NetSerialize(Response[Slot].Timers, Ar, Names[Slot]))
+		{
+			return false;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+bool FModifierRegistry::NetSerializeSchedules(TModifierSlotArray<FModifierMoveResponse>& Response,
+	FArchive& Ar) const
+{
+	if (Ar.IsLoading())
+	{
+		Response.SetNum(NumModifiers());
+	}
+
+	bool bHasSchedules = false;
+	if (Ar.IsSaving())
+	{
+		for (int32 Slot = 0; Slot < NumModifiers(); Slot++)
+		{
+			bHasSchedules |= HasServerTimers(Slot) && Response[Slot].Schedules.Num() > 0;
+		}
+	}
+	Ar.SerializeBits(&bHasSchedules, 1);
+
+	for (int32 Slot = 0; Slot < NumModifiers(); Slot++)
+	{
+		if (!HasServerTimers(Slot))
+		{
+			continue;
+		}
+		if (!bHasSchedules)
+		{
+			Response[Slot].Schedules.Reset();
+		}
+		else if (!FModifierStatics::NetSerialize(Response[Slot].Schedules, Ar, Names[Slot]))
+		{
+			return false;
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+void FModifierRegistry::CombineEffectiveParams(FModifierEffectiveParams& Params, const FVector& Velocity) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FModifierRegistry::CombineEffectiveParams);
+
+	Params.Reset();
+
+	for (const FModifierChannelDef& Def : Channels)
+	{
+		const TModSize Level = *Def.Level;
+
+		// Movement
+		if (Def.MovementParams && Def.MovementParams->IsValidIndex(Level))
+		{
+			Params.AddMovement((*Def.MovementParams)[Level]);
+		}
+
+		// Falling -- only one falling modifier can be in effect, the first registered wins
+		if (Def.FallingParams && Def.FallingParams->IsValidIndex(Level))
+		{
+			Params.AddFalling((*Def.FallingParams)[Level], Velocity);
+		}
+	}
+}
+
+void FModifierHistory::Init(int32 Capacity)
+{
+	Entries.Reset();
+	Entries.SetNum(FMath::Max(Capacity, 0));
+	Reset();
+}
+
+void FModifierHistory::Record(double ServerTime, const FModifierRegistry& Registry, const FModifierEffectiveParams& Params,
+	const FVector& Velocity)
+{
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	if (NumEntries > 0)
+	{
+		const double NewestTime = (*this)[NumEntries - 1].ServerTime;
+		if (ServerTime < NewestTime)
+		{
+			Reset();
+		}
+		else if (ServerTime == NewestTime)
+		{
+			// Same frame, e.g. several moves received together -- keep the final state
+			Head = (Head - 1 + Entries.Num()) % Entries.Num();
+			NumEntries--;
+		}
+	}
+
+	FModifierHistoryEntry& Entry = Entries[Head];
+	Entry.ServerTime = ServerTime;
+	Entry.Levels.SetNumUninitialized(Registry.NumChannels(), EAllowShrinking::No);
+	for (int32 Channel = 0; Channel < Registry.NumChannels(); Channel++)
+	{
+		Entry.Levels[Channel] = *Registry.Channels[Channel].Level;
+	}
+	Entry.Movement = Params.Movement;
+	Entry.RootMotionTranslationScalar = Params.RootMotionTranslationScalar;
+	Entry.bAffectsRootMotion = Params.bAffectsRootMotion;
+	Entry.GravityScalar = Params.bGravityScalarFromVelocityZ && Params.Falling ?
+		Params.Falling->GetGravityScalar(Velocity) : Params.GravityScalar;
+
+	Head = (Head + 1) % Entries.Num();
+	NumEntries = FMath::Min(NumEntries + 1, Entries.Num());
+}
+
+const FModifierHistoryEntry* FModifierHistory::Find(double ServerTime) const
+{
+	// Binary search for the first entry newer than ServerTime, the one before it is in effect
+	int32 Low = 0;
+	int32 High = NumEntries;
+	while (Low < High)
+	{
+		const int32 Mid = Low + (High - Low) / 2;
+		if ((*this)[Mid].ServerTime <= ServerTime)
+		{
+			Low = Mid + 1;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return Low > 0 ? &(*this)[Low - 1] : nullptr;
+}
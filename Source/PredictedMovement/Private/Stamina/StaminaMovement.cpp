@@ -16,6 +16,9 @@ void FStaminaMoveResponseDataContainer::ServerFillResponseData(
 	const UStaminaMovement* MoveComp = Cast<UStaminaMovement>(&CharacterMovement);
 	bStaminaDrained = MoveComp->IsStaminaDrained();
 	Stamina = MoveComp->GetStamina();
+
+	// A full correction carries the stamina anyway
+	bHasStateCorrection = !IsCorrection() && MoveComp->HasPendingStateCorrection();
 }
 
 bool FStaminaMoveResponseDataContainer::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar,
@@ -32,6 +35,16 @@ bool FStaminaMoveResponseDataContainer::Serialize(UCharacterMovementComponent& C
 		Ar << Stamina;
 		Ar << bStaminaDrained;
 	}
+	else
+	{
+		// State-only correction, piggy-backed on the ack
+		Ar.SerializeBits(&bHasStateCorrection, 1);
+		if (bHasStateCorrection)
+		{
+			Ar << Stamina;
+			Ar << bStaminaDrained;
+		}
+	}
 
 	return !Ar.IsError();
 }
@@ -260,14 +273,84 @@ bool UStaminaMovement::ServerCheckClientError(float ClientTimeStamp, float Delta
 	// This will trigger a client correction if the Stamina value in the Client differs NetworkStaminaCorrectionThreshold (2.f default) units from the one in the server
 	// Desyncs can happen if we set the Stamina directly in Gameplay code (ie: GAS)
     const FStaminaNetworkMoveData* CurrentMoveData = static_cast<const FStaminaNetworkMoveData*>(GetCurrentNetworkMoveData());
+    bPendingStateCorrection = false;
     if (!FMath::IsNearlyEqual(CurrentMoveData->Stamina, Stamina, NetworkStaminaCorrectionThreshold))
     {
+        // Position agrees, so send the stamina with the ack rather than rewinding the client
+        if (bUseStateOnlyCorrections)
+        {
+            bPendingStateCorrection = true;
+            return false;
+        }
         return true;
     }
     
     return false;
 }
 
+void UStaminaMovement::ServerSendMoveResponse(const FClientAdjustment& PendingAdjustment)
+{
+	Super::ServerSendMoveResponse(PendingAdjustment);
+
+	// Sent
+	bPendingStateCorrection = false;
+}
+
+void UStaminaMovement::ClientAckGoodMove_Implementation(float TimeStamp)
+{
+	const FStaminaMoveResponseDataContainer& StaminaMoveResponse = static_cast<const FStaminaMoveResponseDataContainer&>(GetMoveResponseDataContainer());
+	if (StaminaMoveResponse.bHasStateCorrection)
+	{
+		OnClientStateCorrectionReceived(TimeStamp, StaminaMoveResponse.Stamina, StaminaMoveResponse.bStaminaDrained);
+	}
+
+	Super::ClientAckGoodMove_Implementation(TimeStamp);
+}
+
+void UStaminaMovement::OnClientStateCorrectionReceived(float TimeStamp, float ServerStamina, bool bServerStaminaDrained)
+{
+	FNetworkPredictionData_Client_Character* ClientData = GetPredictionData_Client_Character();
+	const int32 AckedIndex = ClientData->GetSavedMoveIndex(TimeStamp);
+	if (AckedIndex == INDEX_NONE)
+	{
+		SetStamina(ServerStamina);
+		SetStaminaDrained(bServerStaminaDrained);
+		return;
+	}
+
+	// Offset the moves made since the acked move by the error, instead of replaying them -- any error that remains
+	// is picked up by a later check
+	const FSavedMove_Character_Stamina* AckedMove = static_cast<const FSavedMove_Character_Stamina*>(ClientData->SavedMoves[AckedIndex].Get());
+	const float StaminaError = ServerStamina - AckedMove->EndStamina;
+
+	// Saved moves record the drained state they started with, so the acked move ended with the next move's
+	const bool bStaleStaminaDrained = ClientData->SavedMoves.IsValidIndex(AckedIndex + 1) ?
+		static_cast<const FSavedMove_Character_Stamina*>(ClientData->SavedMoves[AckedIndex + 1].Get())->bStaminaDrained :
+		IsStaminaDrained();
+
+	// Only moves still carrying the stale drained state take the server's, once the client predicted a drain or recovery
+	// of its own that move, those after it and the current state keep it
+	bool bDrainedDiverged = false;
+	for (int32 Index = AckedIndex + 1; Index < ClientData->SavedMoves.Num(); Index++)
+	{
+		FSavedMove_Character_Stamina* SavedMove = static_cast<FSavedMove_Character_Stamina*>(ClientData->SavedMoves[Index].Get());
+		SavedMove->StartStamina = FMath::Clamp(SavedMove->StartStamina + StaminaError, 0.f, MaxStamina);
+		SavedMove->EndStamina = FMath::Clamp(SavedMove->EndStamina + StaminaError, 0.f, MaxStamina);
+
+		bDrainedDiverged |= SavedMove->bStaminaDrained != bStaleStaminaDrained;
+		if (!bDrainedDiverged)
+		{
+			SavedMove->bStaminaDrained = bServerStaminaDrained;
+		}
+	}
+
+	if (!bDrainedDiverged && IsStaminaDrained() == bStaleStaminaDrained)
+	{
+		SetStaminaDrained(bServerStaminaDrained);
+	}
+	SetStamina(GetStamina() + StaminaError);
+}
+
 FNetworkPredictionData_Client* UStaminaMovement::GetPredictionData_Client() const
 {
 	if (ClientPredictionData == nullptr)
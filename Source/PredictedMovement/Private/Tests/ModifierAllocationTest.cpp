@@ -0,0 +1,211 @@
+// Copyright (c) Jared Taylor
+
+
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/AutomationTest.h"
+#include "Modifier/ModifierRegistry.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ModifierAllocationTest
+{
+	/**
+	 * Forwards to the allocator it replaces, counting the allocations made by a single thread
+	 * Other threads keep allocating while it is installed, they pass straight through
+	 */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FCountingMalloc(FMalloc* InInner, uint32 InThreadId)
+			: Inner(InInner)
+			, ThreadId(InThreadId)
+		{}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				CountAllocation();
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override
+		{
+			Inner->Free(Original);
+		}
+
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override
+		{
+			return Inner->GetAllocationSize(Original, SizeOut);
+		}
+
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override
+		{
+			return Inner->QuantizeSize(Count, Alignment);
+		}
+
+		virtual bool IsInternallyThreadSafe() const override
+		{
+			return Inner->IsInternallyThreadSafe();
+		}
+
+		virtual const TCHAR* GetDescriptiveName() override
+		{
+			return TEXT("ModifierAllocationTest");
+		}
+
+		int32 GetNumAllocations() const { return NumAllocations; }
+
+	private:
+		void CountAllocation()
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				NumAllocations++;
+			}
+		}
+
+		FMalloc* Inner;
+		uint32 ThreadId;
+		int32 NumAllocations = 0;
+	};
+
+	/** Installs a FCountingMalloc for the current thread while in scope */
+	struct FScopedAllocationCounter
+	{
+		FScopedAllocationCounter()
+			: Previous(GMalloc)
+			, Counter(GMalloc, FPlatformTLS::GetCurrentThreadId())
+		{
+			GMalloc = &Counter;
+		}
+
+		~FScopedAllocationCounter()
+		{
+			GMalloc = Previous;
+		}
+
+		int32 GetNumAllocations() const { return Counter.GetNumAllocations(); }
+
+	private:
+		FMalloc* Previous;
+		FCountingMalloc Counter;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierAllocationTest, "PredictedMovement.Modifier.Allocations",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierAllocationTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierAllocationTest;
+
+	// A channel with a client predicted and a corrected modifier, as UModifierMovement registers them
+	TModSize Level = NO_MODIFIER;
+	const TArray<FGameplayTag> LevelTags = { FGameplayTag(), FGameplayTag(), FGameplayTag(), FGameplayTag() };
+	const EModifierLevelMethod LevelMethod = EModifierLevelMethod::Max;
+	const bool bLimitMaxModifiers = true;
+	const int32 MaxModifiers = MODIFIER_STACK_INLINE_CAPACITY;
+
+	FModifierChannelDef Def;
+	Def.Level = &Level;
+	Def.LevelTags = &LevelTags;
+	Def.LevelMethod = &LevelMethod;
+	Def.bLimitMaxModifiers = &bLimitMaxModifiers;
+	Def.MaxModifiers = &MaxModifiers;
+
+	FMovementModifier Local;
+	FMovementModifier Correction;
+	FModifierRegistry Registry;
+	const int32 Channel = Registry.AddChannel(MoveTemp(Def));
+	const int32 LocalSlot = Registry.AddModifier(Channel, Local, EModifierNetType::LocalPredicted, TEXT("Local"));
+	const int32 CorrectionSlot = Registry.AddModifier(Channel, Correction, EModifierNetType::WithCorrection, TEXT("Correction"));
+	Registry.InitNetLimits();
+
+	TModifierSlotArray<FModifierSavedMove_WithCorrection> SavedMove;
+	SavedMove.SetNum(Registry.NumModifiers());
+	TModifierSlotArray<FModifierMoveData_WithCorrection> MoveData;
+	MoveData.SetNum(Registry.NumModifiers());
+	TModifierSlotArray<FModifierMoveData_WithCorrection> ReceivedMoveData;
+	ReceivedMoveData.SetNum(Registry.NumModifiers());
+
+	// One move: add modifiers, process the channel, save the move, and pack it for the server
+	auto RunMove = [&](FBitWriter& Writer, int32 NumAdded)
+	{
+		for (int32 i = 0; i < NumAdded; i++)
+		{
+			Local.AddModifier(1);
+			Correction.AddModifier(2);
+			Correction.AddModifier(2);
+		}
+		Registry.ProcessChannel(Channel);
+
+		for (int32 Slot = 0; Slot < Registry.NumModifiers(); Slot++)
+		{
+			FMovementModifier& Modifier = *Registry.Modifiers[Slot];
+			SavedMove[Slot].SetMoveFor(Modifier.WantsModifiers);
+			SavedMove[Slot].PostUpdate(Modifier.Modifiers);
+			MoveData[Slot].ClientFillNetworkMoveData(SavedMove[Slot].WantsModifiers, SavedMove[Slot].MarkSent());
+		}
+
+		Registry.NetSerializeMoveData(MoveData, Writer, false, nullptr);
+
+		Local.RemoveModifier(1, true);
+		Correction.RemoveModifier(2, true);
+		Registry.ProcessChannel(Channel);
+
+		for (FModifierSavedMove_WithCorrection& SlotMove : SavedMove)
+		{
+			SlotMove.Clear();
+		}
+	};
+
+	// Everything that allocates on first use is built up front, the same as a component after its first moves
+	FBitWriter WarmupWriter(1024, false);
+	RunMove(WarmupWriter, 1);
+	FBitWriter Writer(1024, false);
+	FBitReader Reader(WarmupWriter.GetData(), WarmupWriter.GetNumBits());
+
+	int32 NumAllocations = 0;
+	{
+		FScopedAllocationCounter Counter;
+		RunMove(Writer, 1);
+		Registry.NetSerializeMoveData(ReceivedMoveData, Reader, false, nullptr);
+		NumAllocations = Counter.GetNumAllocations();
+	}
+
+	TestEqual(TEXT("Process, save and serialize don't allocate"), NumAllocations, 0);
+	TestFalse(TEXT("Move data was written"), Writer.IsError());
+	TestFalse(TEXT("Move data was read"), Reader.IsError());
+	TestTrue(TEXT("Move data matches the warmup move"), Writer.GetNumBits() == WarmupWriter.GetNumBits() &&
+		FMemory::Memcmp(Writer.GetData(), WarmupWriter.GetData(), Writer.GetNumBytes()) == 0);
+	TestTrue(TEXT("Received wanted stack"), ReceivedMoveData[LocalSlot].WantsModifiers == MoveData[LocalSlot].WantsModifiers);
+	TestTrue(TEXT("Received corrected stack"), ReceivedMoveData[CorrectionSlot].Modifiers == MoveData[CorrectionSlot].Modifiers);
+
+	// Spamming far past the inline capacity keeps every wanted stack at the cap, so nothing spills to the heap
+	FBitWriter SpamWriter(1024, false);
+	{
+		FScopedAllocationCounter Counter;
+		RunMove(SpamWriter, MODIFIER_STACK_INLINE_CAPACITY * 4);
+		NumAllocations = Counter.GetNumAllocations();
+	}
+
+	TestEqual(TEXT("Moves at the cap don't allocate"), NumAllocations, 0);
+	TestEqual(TEXT("Sent wanted stack is at the cap"), MoveData[LocalSlot].WantsModifiers.Num(), MaxModifiers);
+	TestEqual(TEXT("Sent corrected stack is at the cap"), MoveData[CorrectionSlot].WantsModifiers.Num(), MaxModifiers);
+	TestFalse(TEXT("Moves at the cap were written"), SpamWriter.IsError());
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
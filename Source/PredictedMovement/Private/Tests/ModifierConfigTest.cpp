@@ -0,0 +1,44 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Misc/AutomationTest.h"
+#include "Modifier/ModifierMovement.h"
+#include "Modifier/ModifierMovementConfig.h"
+#include "Modifier/ModifierTags.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierConfigCopyOnWriteTest, "PredictedMovement.Modifier.Config.CopyOnWrite",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierConfigCopyOnWriteTest::RunTest(const FString& Parameters)
+{
+	UModifierMovement* Shared = NewObject<UModifierMovement>(GetTransientPackage());
+	UModifierMovement* Overridden = NewObject<UModifierMovement>(GetTransientPackage());
+	Shared->BakeModifierLevels();
+	Overridden->BakeModifierLevels();
+
+	const UModifierMovementConfig* Defaults = GetDefault<UModifierMovementConfig>();
+	TestTrue(TEXT("Components without a config use the class defaults"), Shared->GetModifierConfig() == Defaults);
+	TestTrue(TEXT("Components share the level tables of their config"),
+		&Shared->BoostLevelTable.Get() == &Overridden->BoostLevelTable.Get() &&
+		&Shared->BoostLevelTable.Get() == &Defaults->BoostLevelTable.Get());
+
+	// Override the params of a single component
+	UModifierMovementConfig* Config = Overridden->GetMutableModifierConfig();
+	TestTrue(TEXT("Mutable config is a copy"), Config != Defaults && Overridden->GetModifierConfig() == Config);
+	TestTrue(TEXT("Mutable config is made once"), Overridden->GetMutableModifierConfig() == Config);
+	Config->Boost.FindOrAdd(FModifierTags::Modifier_Boost).MaxWalkSpeed = 2.f;
+	Overridden->BakeModifierLevels();
+
+	const uint8 Level = Overridden->GetBoostLevelIndex(FModifierTags::Modifier_Boost);
+	TestEqual(TEXT("Overridden component uses its own params"), Overridden->BoostLevelTable->Params[Level].MaxWalkSpeed, 2.f);
+	TestEqual(TEXT("Shared component keeps the shared params"), Shared->BoostLevelTable->Params[Level].MaxWalkSpeed, 1.5f);
+	TestEqual(TEXT("Class defaults are untouched"), Defaults->Boost.FindChecked(FModifierTags::Modifier_Boost).MaxWalkSpeed, 1.5f);
+	TestTrue(TEXT("Shared component keeps the shared tables"), &Shared->BoostLevelTable.Get() == &Defaults->BoostLevelTable.Get());
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,52 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Misc/AutomationTest.h"
+#include "Modifier/ModifierRegistry.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierRegistryLevelPolicyTest, "PredictedMovement.Modifier.Registry.LevelPolicy",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierRegistryLevelPolicyTest::RunTest(const FString& Parameters)
+{
+	// Channels are processed with the compile-time policy of their level method, and bound again when it changes
+	TModSize Level = NO_MODIFIER;
+	const TArray<FGameplayTag> LevelTags = { FGameplayTag(), FGameplayTag(), FGameplayTag(), FGameplayTag() };
+	EModifierLevelMethod LevelMethod = EModifierLevelMethod::Max;
+	const bool bLimitMaxModifiers = true;
+	const int32 MaxModifiers = 4;
+
+	FModifierChannelDef Def;
+	Def.Level = &Level;
+	Def.LevelTags = &LevelTags;
+	Def.LevelMethod = &LevelMethod;
+	Def.bLimitMaxModifiers = &bLimitMaxModifiers;
+	Def.MaxModifiers = &MaxModifiers;
+
+	FMovementModifier Modifier;
+	FModifierRegistry Registry;
+	const int32 Channel = Registry.AddChannel(MoveTemp(Def));
+	Registry.AddModifier(Channel, Modifier, EModifierNetType::LocalPredicted, TEXT("Test"));
+
+	const FModifierChannelDef::FProcessLevelsFunc MaxPolicy = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Max>;
+	const FModifierChannelDef::FProcessLevelsFunc MinPolicy = &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Min>;
+	TestTrue(TEXT("Registered channel is bound to its policy"), Registry.Channels[Channel].ProcessLevels == MaxPolicy);
+
+	Modifier.AddModifier(1);
+	Modifier.AddModifier(3);
+	TestTrue(TEXT("Channel changed"), Registry.ProcessChannel(Channel));
+	TestEqual(TEXT("Max level"), static_cast<int32>(Level), 3);
+
+	// Nothing wanted changed, but the method did, so the level is evaluated again with the new policy
+	LevelMethod = EModifierLevelMethod::Min;
+	TestTrue(TEXT("Channel changed with the method"), Registry.ProcessChannel(Channel));
+	TestTrue(TEXT("Channel is bound to the new policy"), Registry.Channels[Channel].ProcessLevels == MinPolicy);
+	TestEqual(TEXT("Min level"), static_cast<int32>(Level), 1);
+	TestFalse(TEXT("Channel is clean once evaluated"), Registry.ProcessChannel(Channel));
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
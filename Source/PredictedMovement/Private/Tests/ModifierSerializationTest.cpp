@@ -0,0 +1,394 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Misc/AutomationTest.h"
+#include "Modifier/ModifierRegistry.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ModifierSerializationTest
+{
+	static const FString ErrorName = TEXT("Test");
+
+	/** Write Stack then read it back, as the server reads what the client sent */
+	bool RoundTrip(const TModifierStack& Stack, TModifierStack& OutStack, int32 NumLevels, int32 MaxSerializedModifiers,
+		int64* OutNumBits = nullptr)
+	{
+		FBitWriter Writer(1024, true);
+		TModifierStack Saved = Stack;
+		if (!FModifierStatics::NetSerializePacked(Saved, Writer, ErrorName, NumLevels, MaxSerializedModifiers))
+		{
+			return false;
+		}
+
+		if (OutNumBits)
+		{
+			*OutNumBits = Writer.GetNumBits();
+		}
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		return FModifierStatics::NetSerializePacked(OutStack, Reader, ErrorName, NumLevels, MaxSerializedModifiers) &&
+			!Reader.IsError() && Reader.GetBitsLeft() == 0;
+	}
+
+	TModifierStack MakeStack(std::initializer_list<TModSize> Levels)
+	{
+		TModifierStack Stack;
+		Stack.Append(Levels.begin(), Levels.size());
+		return Stack;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationRoundTripTest, "PredictedMovement.Modifier.Serialization.RoundTrip",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierSerializationTest;
+
+	// A max of 0 writes nothing, and reads an empty stack
+	{
+		TModifierStack Out = MakeStack({ 1 });
+		int64 NumBits = INDEX_NONE;
+		TestTrue(TEXT("Max 0 round trips"), RoundTrip(MakeStack({ 1, 2 }), Out, 4, 0, &NumBits));
+		TestEqual(TEXT("Max 0 writes no bits"), NumBits, 0ll);
+		TestEqual(TEXT("Max 0 reads an empty stack"), Out.Num(), 0);
+	}
+
+	// A max of 1 keeps the newest entry
+	{
+		TModifierStack Out;
+		TestTrue(TEXT("Max 1 round trips"), RoundTrip(MakeStack({ 1, 3 }), Out, 4, 1));
+		TestTrue(TEXT("Max 1 keeps the newest entry"), Out == MakeStack({ 3 }));
+	}
+
+	// Empty stacks
+	{
+		TModifierStack Out = MakeStack({ 2 });
+		TestTrue(TEXT("Empty stack round trips"), RoundTrip(TModifierStack(), Out, 4, 8));
+		TestEqual(TEXT("Empty stack reads empty"), Out.Num(), 0);
+	}
+
+	// A single level channel needs no bits per level
+	{
+		TModifierStack Out;
+		TestTrue(TEXT("Single level round trips"), RoundTrip(MakeStack({ 0, 0, 0 }), Out, 1, 8));
+		TestTrue(TEXT("Single level matches"), Out == MakeStack({ 0, 0, 0 }));
+	}
+
+	// Truncation keeps the newest entries, which are the ones applied when the stack exceeds the max
+	{
+		TModifierStack Out;
+		TestTrue(TEXT("Truncated stack round trips"), RoundTrip(MakeStack({ 0, 1, 2, 3, 0 }), Out, 4, 3));
+		TestTrue(TEXT("Truncated stack keeps the newest"), Out == MakeStack({ 2, 3, 0 }));
+	}
+
+	// The largest cap TModSize can count, with a cap above it clamped to it
+	{
+		TModifierStack Stack;
+		for (int32 i = 0; i < NO_MODIFIER - 1; i++)
+		{
+			Stack.Add(static_cast<TModSize>(i % 5));
+		}
+
+		TModifierStack Out;
+		TestTrue(TEXT("Max cap round trips"), RoundTrip(Stack, Out, 5, NO_MODIFIER - 1));
+		TestTrue(TEXT("Max cap matches"), Out == Stack);
+
+		Stack.Add(4);
+		TestTrue(TEXT("Above max cap round trips"), RoundTrip(Stack, Out, 5, 1000));
+		TestEqual(TEXT("Above max cap is clamped"), Out.Num(), NO_MODIFIER - 1);
+		TestEqual(TEXT("Above max cap keeps the newest"), static_cast<int32>(Out.Last()), 4);
+	}
+
+	// Levels out of range of the channel fail the write rather than sending a different level
+	{
+		AddExpectedError(TEXT("Levels can't be added after the component registers"), EAutomationExpectedErrorFlags::Contains, 1);
+
+		FBitWriter Writer(1024, true);
+		TModifierStack Stack = MakeStack({ 1, 9 });
+		TestFalse(TEXT("Out of range level fails the write"),
+			FModifierStatics::NetSerializePacked(Stack, Writer, ErrorName, 4, 8));
+		TestTrue(TEXT("Out of range level sets the archive error"), Writer.IsError());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationRunLengthTest, "PredictedMovement.Modifier.Serialization.RunLength",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationRunLengthTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierSerializationTest;
+
+	// Repeated levels are run length encoded, which must be smaller than a level per modifier
+	const TModifierStack Repeated = MakeStack({ 2, 2, 2, 2, 2, 2, 5, 5 });
+	const TModifierStack Distinct = MakeStack({ 0, 1, 2, 3, 4, 5, 6, 7 });
+
+	TModifierStack Out;
+	int64 RepeatedBits = 0;
+	int64 DistinctBits = 0;
+	TestTrue(TEXT("Repeated levels round trip"), RoundTrip(Repeated, Out, 8, 8, &RepeatedBits));
+	TestTrue(TEXT("Repeated levels match"), Out == Repeated);
+	TestTrue(TEXT("Distinct levels round trip"), RoundTrip(Distinct, Out, 8, 8, &DistinctBits));
+	TestTrue(TEXT("Distinct levels match"), Out == Distinct);
+	TestTrue(TEXT("Run length encoding is smaller"), RepeatedBits < DistinctBits);
+
+	// A run that fills the whole cap
+	const TModifierStack Full = MakeStack({ 1, 1, 1, 1 });
+	TestTrue(TEXT("Full run round trips"), RoundTrip(Full, Out, 2, 4));
+	TestTrue(TEXT("Full run matches"), Out == Full);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationMalformedTest, "PredictedMovement.Modifier.Serialization.Malformed",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationMalformedTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierSerializationTest;
+
+	// Byte archives read whole values instead of the bits of the range, so they can hold anything
+	auto ReadBytes = [](TFunctionRef<void(FArchive&)> Write, int32 NumLevels, int32 MaxSerializedModifiers)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes);
+		Write(Writer);
+
+		FMemoryReader Reader(Bytes);
+		TModifierStack Out;
+		const bool bResult = FModifierStatics::NetSerializePacked(Out, Reader, ErrorName, NumLevels, MaxSerializedModifiers);
+		return bResult && !Reader.IsError();
+	};
+
+	TestFalse(TEXT("Count above the max is rejected"), ReadBytes([](FArchive& Ar)
+	{
+		bool bRunLength = false;
+		uint32 NumModifiers = 4;
+		Ar.SerializeBits(&bRunLength, 1);
+		Ar << NumModifiers;
+	}, 4, 3));
+
+	TestFalse(TEXT("Level above the channel's levels is rejected"), ReadBytes([](FArchive& Ar)
+	{
+		bool bRunLength = false;
+		uint32 NumModifiers = 1;
+		uint32 Level = 7;
+		Ar.SerializeBits(&bRunLength, 1);
+		Ar << NumModifiers << Level;
+	}, 4, 3));
+
+	TestFalse(TEXT("Run longer than the max is rejected"), ReadBytes([](FArchive& Ar)
+	{
+		bool bRunLength = true;
+		uint32 NumRuns = 1;
+		uint32 Level = 0;
+		uint32 ExtraLength = 5;
+		Ar.SerializeBits(&bRunLength, 1);
+		Ar << NumRuns << Level << ExtraLength;
+	}, 4, 3));
+
+	TestTrue(TEXT("Valid byte archive is accepted"), ReadBytes([](FArchive& Ar)
+	{
+		bool bRunLength = false;
+		uint32 NumModifiers = 2;
+		uint32 Levels[] = { 1, 3 };
+		Ar.SerializeBits(&bRunLength, 1);
+		Ar << NumModifiers << Levels[0] << Levels[1];
+	}, 4, 3));
+
+	// Runs are each in range, but add up to more than the cap
+	{
+		FBitWriter Writer(64, true);
+		bool bRunLength = true;
+		uint32 NumRuns = 2;
+		uint32 Level = 0;
+		uint32 ExtraLength = 2;
+		Writer.SerializeBits(&bRunLength, 1);
+		Writer.SerializeInt(NumRuns, 4);
+		Writer.SerializeInt(Level, 4);
+		Writer.SerializeInt(ExtraLength, 3);
+		Writer.SerializeInt(Level, 4);
+		Writer.SerializeInt(ExtraLength, 3);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		TModifierStack Out;
+		TestFalse(TEXT("Runs adding up to more than the max are rejected"),
+			FModifierStatics::NetSerializePacked(Out, Reader, ErrorName, 4, 3));
+		TestTrue(TEXT("Rejected runs set the archive error"), Reader.IsError());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationRegistryTest, "PredictedMovement.Modifier.Serialization.Registry",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationRegistryTest::RunTest(const FString& Parameters)
+{
+	// The bit widths come from the limits captured when the component registers, not the live limits
+	TModSize Level = NO_MODIFIER;
+	const TArray<FGameplayTag> LevelTags = { FGameplayTag(), FGameplayTag(), FGameplayTag(), FGameplayTag() };
+	const EModifierLevelMethod LevelMethod = EModifierLevelMethod::Max;
+	bool bLimitMaxModifiers = true;
+	int32 MaxModifiers = 4;
+
+	FModifierChannelDef Def;
+	Def.Level = &Level;
+	Def.LevelTags = &LevelTags;
+	Def.LevelMethod = &LevelMethod;
+	Def.bLimitMaxModifiers = &bLimitMaxModifiers;
+	Def.MaxModifiers = &MaxModifiers;
+
+	FMovementModifier Modifier;
+	FModifierRegistry Registry;
+	const int32 Channel = Registry.AddChannel(MoveTemp(Def));
+	const int32 Slot = Registry.AddModifier(Channel, Modifier, EModifierNetType::WithCorrection, TEXT("Test"));
+	Registry.InitNetLimits();
+
+	TModifierStack Stack = ModifierSerializationTest::MakeStack({ 0, 1, 2, 3 });
+	FBitWriter Writer(1024, true);
+	TestTrue(TEXT("Registry writes the stack"), Registry.NetSerializeStack(Slot, Stack, Writer));
+
+	// Gameplay changes the limit on one side only, and bakes again
+	MaxModifiers = 1;
+	bLimitMaxModifiers = false;
+	Registry.InitNetLimits();
+	TestEqual(TEXT("Registered max modifiers is kept"), Registry.Channels[Channel].NetMaxModifiers, 4);
+
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	TModifierStack Out;
+	TestTrue(TEXT("Registry reads the stack"), Registry.NetSerializeStack(Slot, Out, Reader));
+	TestTrue(TEXT("Registry stack matches"), Out == Stack);
+	TestEqual(TEXT("Registry reads every bit written"), Reader.GetBitsLeft(), 0ll);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationTimersTest, "PredictedMovement.Modifier.Serialization.Timers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationTimersTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierSerializationTest;
+
+	// A count that doesn't fit a byte still sends the newest timers up to the max
+	{
+		TModifierTimers Timers;
+		for (int32 i = 0; i < 256; i++)
+		{
+			Timers.Add({ static_cast<TModSize>(i % 4), static_cast<float>(i) });
+		}
+
+		FBitWriter Writer(4096, true);
+		TestTrue(TEXT("Timers write"), FModifierStatics::NetSerialize(Timers, Writer, ErrorName, 8));
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		TModifierTimers Out;
+		TestTrue(TEXT("Timers read"), FModifierStatics::NetSerialize(Out, Reader, ErrorName, 8));
+		TestEqual(TEXT("Timers are clamped to the max"), Out.Num(), 8);
+		TestTrue(TEXT("Timers keep the newest"), Out.Num() == 8 && Out.Last() == Timers.Last() && Out[0] == Timers[248]);
+	}
+
+	// A count above the max is rejected rather than read short, which would misalign the rest of the packet
+	{
+		TModifierTimers Timers;
+		for (int32 i = 0; i < 8; i++)
+		{
+			Timers.Add({ 1, static_cast<float>(i) });
+		}
+
+		FBitWriter Writer(1024, true);
+		FModifierStatics::NetSerialize(Timers, Writer, ErrorName, 8);
+
+		FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+		TModifierTimers Out;
+		TestFalse(TEXT("Timers above the max are rejected"), FModifierStatics::NetSerialize(Out, Reader, ErrorName, 4));
+		TestTrue(TEXT("Rejected timers set the archive error"), Reader.IsError());
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSerializationWantedCapTest, "PredictedMovement.Modifier.Serialization.WantedCap",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSerializationWantedCapTest::RunTest(const FString& Parameters)
+{
+	// Spamming modifiers caps the wanted stack at the registered max, the same on both sides and the same as what is sent
+	TModSize Level = NO_MODIFIER;
+	const TArray<FGameplayTag> LevelTags = { FGameplayTag(), FGameplayTag(), FGameplayTag(), FGameplayTag() };
+	const EModifierLevelMethod LevelMethod = EModifierLevelMethod::Max;
+	const bool bLimitMaxModifiers = true;
+	const int32 MaxModifiers = 4;
+
+	auto MakeDef = [&]()
+	{
+		FModifierChannelDef Def;
+		Def.Level = &Level;
+		Def.LevelTags = &LevelTags;
+		Def.LevelMethod = &LevelMethod;
+		Def.bLimitMaxModifiers = &bLimitMaxModifiers;
+		Def.MaxModifiers = &MaxModifiers;
+		return Def;
+	};
+
+	FMovementModifier Client;
+	FModifierRegistry ClientRegistry;
+	const int32 Slot = ClientRegistry.AddModifier(ClientRegistry.AddChannel(MakeDef()), Client, EModifierNetType::WithCorrection, TEXT("Client"));
+	ClientRegistry.InitNetLimits();
+
+	FMovementModifier Server;
+	FModifierRegistry ServerRegistry;
+	ServerRegistry.AddModifier(ServerRegistry.AddChannel(MakeDef()), Server, EModifierNetType::WithCorrection, TEXT("Server"));
+	ServerRegistry.InitNetLimits();
+
+	// Add N and remove M on both sides, mixing timed and untimed modifiers
+	constexpr int32 NumAdded = 40;
+	for (FMovementModifier* Modifier : { &Client, &Server })
+	{
+		for (int32 i = 0; i < NumAdded; i++)
+		{
+			const TModSize AddLevel = static_cast<TModSize>(i % LevelTags.Num());
+			if (i % 3 == 0)
+			{
+				Modifier->AddTimedModifier(AddLevel, static_cast<float>(i));
+			}
+			else
+			{
+				Modifier->AddModifier(AddLevel);
+			}
+
+			if (i % 5 == 4)
+			{
+				Modifier->RemoveModifier(static_cast<TModSize>((i + 1) % LevelTags.Num()), false);
+			}
+		}
+	}
+
+	TestTrue(TEXT("Wanted stack is capped"), Client.WantsModifiers.Num() <= MaxModifiers);
+	TestTrue(TEXT("Wanted stacks match"), Client.WantsModifiers == Server.WantsModifiers);
+	TestTrue(TEXT("Timers match"), Client.Timers == Server.Timers);
+	TestTrue(TEXT("Timers don't outnumber the wanted stack"), Client.Timers.Num() <= Client.WantsModifiers.Num());
+	TestEqual(TEXT("Wanted counts match the stack"), static_cast<int32>(Client.GetNumWantedModifiersByLevel(3)),
+		Client.WantsModifiers.FilterByPredicate([](TModSize Wanted) { return Wanted == 3; }).Num());
+
+	// What is sent is the whole wanted stack, so the server doesn't apply a different window than the client
+	TModifierStack Sent = Client.WantsModifiers;
+	FBitWriter Writer(1024, true);
+	TestTrue(TEXT("Wanted stack writes"), ClientRegistry.NetSerializeStack(Slot, Sent, Writer));
+	FBitReader Reader(Writer.GetData(), Writer.GetNumBits());
+	TModifierStack Received;
+	TestTrue(TEXT("Wanted stack reads"), ServerRegistry.NetSerializeStack(Slot, Received, Reader));
+	TestTrue(TEXT("Received stack matches both sides"), Received == Server.WantsModifiers);
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
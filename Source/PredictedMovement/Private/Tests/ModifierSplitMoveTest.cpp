@@ -0,0 +1,97 @@
+// Copyright (c) Jared Taylor
+
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Modifier/ModifierCharacter.h"
+#include "Modifier/ModifierMovement.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ModifierSplitMoveTest
+{
+	/** A character falling freely, that moves without a controller when its movement is ticked by hand */
+	UModifierMovement* SpawnCharacter(UWorld* World, const FVector& Location)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		const AModifierCharacter* Character = World->SpawnActor<AModifierCharacter>(Location, FRotator::ZeroRotator, SpawnParams);
+		UModifierMovement* MoveComp = Character ? Character->GetModifierCharacterMovement() : nullptr;
+		if (MoveComp)
+		{
+			MoveComp->bRunPhysicsWithNoController = true;
+			MoveComp->SetMovementMode(MOVE_Falling);
+			MoveComp->Velocity = FVector(300.f, 0.f, -200.f);
+		}
+		return MoveComp;
+	}
+
+	/** Perform a single move */
+	void Move(UModifierMovement* MoveComp, float DeltaTime)
+	{
+		MoveComp->TickComponent(DeltaTime, LEVELTICK_All, &MoveComp->PrimaryComponentTick);
+	}
+
+	FVector GetLocation(const UModifierMovement* MoveComp)
+	{
+		return MoveComp->UpdatedComponent->GetComponentLocation();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FModifierSplitMoveTest, "PredictedMovement.Modifier.SplitMove",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ServerContext | EAutomationTestFlags::EngineFilter)
+
+bool FModifierSplitMoveTest::RunTest(const FString& Parameters)
+{
+	using namespace ModifierSplitMoveTest;
+
+	if (!GEngine)
+	{
+		AddError(TEXT("Requires an engine to create a world"));
+		return false;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	// Far enough apart that they never touch, and the world is otherwise empty
+	UModifierMovement* Unsplit = SpawnCharacter(World, FVector::ZeroVector);
+	UModifierMovement* Split = SpawnCharacter(World, FVector(10000.f, 0.f, 0.f));
+
+	if (TestNotNull(TEXT("Unsplit character"), Unsplit) && TestNotNull(TEXT("Split character"), Split))
+	{
+		// Two moves made by the client, the second one with SlowFall, combined into one move that switches part way
+		constexpr float DeltaTime = 0.05f;
+		const uint8 SubMoveAlpha = FModifierStatics::QuantizeSubMoveAlpha(0.02f, DeltaTime);
+		const float SubMoveTime = FModifierStatics::GetSubMoveTime(SubMoveAlpha, DeltaTime);
+		const TModifierStack SlowFall = { 0 };
+
+		const FVector UnsplitStart = GetLocation(Unsplit);
+		Move(Unsplit, SubMoveTime);
+		Unsplit->SlowFallLocal.SetWantsModifiers(SlowFall);
+		Move(Unsplit, DeltaTime - SubMoveTime);
+
+		const FVector SplitStart = GetLocation(Split);
+		const int32 Slot = Split->GetModifierRegistry().Modifiers.IndexOfByKey(&Split->SlowFallLocal);
+		Split->QueueWantsChange(Slot, SlowFall, SubMoveAlpha);
+		Move(Split, DeltaTime);
+
+		TestTrue(TEXT("SlowFall is active"), Split->IsSlowFallActive());
+		TestEqual(TEXT("Split move ends with the same level"), static_cast<int32>(Split->SlowFallLevel), static_cast<int32>(Unsplit->SlowFallLevel));
+		TestTrue(TEXT("Split move ends with the new wanted stack"), Split->SlowFallLocal.WantsModifiers == SlowFall);
+		TestTrue(TEXT("Split move travels as far as the moves did"),
+			(GetLocation(Split) - SplitStart).Equals(GetLocation(Unsplit) - UnsplitStart, 0.01f));
+		TestTrue(TEXT("Split move ends with the same velocity"), Split->Velocity.Equals(Unsplit->Velocity, 0.01f));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	return true;
+}
+
+#endif  // WITH_DEV_AUTOMATION_TESTS
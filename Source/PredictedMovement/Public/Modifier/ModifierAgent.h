@@ -0,0 +1,100 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ModifierRegistry.h"
+
+/** A channel of FModifierAgentConfig, e.g. Boost */
+struct PREDICTEDMOVEMENT_API FModifierAgentChannel
+{
+	FGameplayTag ModifierType;
+
+	EModifierLevelMethod LevelMethod = EModifierLevelMethod::Max;
+
+	/** Maximum number of modifiers applied at once, 0 for no limit */
+	int32 MaxModifiers = 0;
+
+	/** Baked tables shared with the movement component the config was made from, one of these is set */
+	TSharedPtr<const TModifierLevelTable<FMovementModifierParams>> MovementTable;
+	TSharedPtr<const TModifierLevelTable<FFallingModifierParams>> FallingTable;
+
+	int32 NumLevels() const
+	{
+		return MovementTable.IsValid() ? MovementTable->Levels.Num() : FallingTable.IsValid() ? FallingTable->Levels.Num() : 0;
+	}
+};
+
+/**
+ * Modifier tuning for lightweight agents that don't have a UModifierMovement, e.g. crowds, see FModifierAgentState
+ * Made by UModifierMovement::GetModifierAgentConfig() from the same baked tables the component uses, so tuning applies
+ * identically to both
+ * Immutable once made, and shared by every agent using it
+ */
+struct PREDICTEDMOVEMENT_API FModifierAgentConfig
+{
+	TModifierChannelArray<FModifierAgentChannel> Channels;
+
+	int32 NumChannels() const { return Channels.Num(); }
+
+	int32 FindChannel(const FGameplayTag& ModifierType) const
+	{
+		return Channels.IndexOfByPredicate([&ModifierType](const FModifierAgentChannel& Channel) { return Channel.ModifierType == ModifierType; });
+	}
+
+	/** @return The level index of a level tag, or NO_MODIFIER if the channel doesn't have it */
+	TModSize GetLevelIndex(int32 Channel, const FGameplayTag& Level) const;
+
+	/**
+	 * @return Hash of the tuning, equal for configs made from components that share their baked tables
+	 * Tables are hashed by identity, they are immutable and shared with the archetype whenever they match it
+	 */
+	uint32 GetTuningHash() const;
+};
+
+/**
+ * Modifier state of an agent without a UModifierMovement, e.g. one entity of a crowd
+ * Levels resolve with the same aggregation as the component, but there is nothing to predict or replicate, so modifiers
+ * are applied directly instead of being wanted first
+ * Holds no UObjects, so agents can be stored in any container and evaluated on any thread, e.g. FModifierAgentFragment
+ */
+struct PREDICTEDMOVEMENT_API FModifierAgentState
+{
+	/** Applied modifiers, indexed by channel */
+	TModifierChannelArray<TModifierStack> Modifiers;
+
+	/** Current level, indexed by channel */
+	TModifierChannelArray<TModSize> Levels;
+
+	/** Combined params of every active level, see UModifierMovement::GetEffectiveModifierParams() */
+	FModifierEffectiveParams Params;
+
+	/** Set when a modifier is added or removed, cleared by Evaluate() */
+	bool bDirty = true;
+
+	void Init(const FModifierAgentConfig& Config);
+
+	/** @return True if the modifier was added, false if the channel is at its MaxModifiers */
+	bool AddModifier(const FModifierAgentConfig& Config, int32 Channel, TModSize Level);
+
+	/** @return True if any modifier was removed */
+	bool RemoveModifier(int32 Channel, TModSize Level, bool bRemoveAll = false);
+
+	void ResetModifiers(int32 Channel);
+
+	/**
+	 * Resolve the level of every channel and recombine Params if a modifier was added or removed
+	 * @param Velocity Used by falling modifiers, see FFallingModifierParams::GetGravityScalar()
+	 * @return True if anything was evaluated
+	 */
+	bool Evaluate(const FModifierAgentConfig& Config, const FVector& Velocity);
+
+	/**
+	 * Evaluate many agents that share a config, split into chunks across worker threads
+	 * @param Velocities Indexed the same as Agents, or empty to evaluate with no velocity
+	 * @param ChunkSize Agents evaluated per task
+	 */
+	static void EvaluateAgents(const FModifierAgentConfig& Config, TArrayView<FModifierAgentState> Agents,
+		TArrayView<const FVector> Velocities, int32 ChunkSize = 256);
+};
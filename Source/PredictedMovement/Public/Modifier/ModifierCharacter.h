@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "ModifierTypes.h"
+#include "ModifierRegistry.h"
 #include "GameFramework/Character.h"
 #include "ModifierCharacter.generated.h"
 
@@ -31,8 +32,30 @@ public:
 	AModifierCharacter(const FObjectInitializer& FObjectInitializer);
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-	
+	virtual void PostInitializeComponents() override;
+
+protected:
+	/** Sets the level a channel replicates to simulated proxies, e.g. SimulatedBoost, and marks it dirty */
+	using FSetSimulatedLevelFunc = void(*)(AModifierCharacter& Character, uint8 Level);
+
+	/** Indexed by registered channel, null for channels that don't replicate to simulated proxies */
+	TModifierChannelArray<FSetSimulatedLevelFunc> SimulatedLevelSetters;
+
+	/**
+	 * Binds the simulated level of each channel, called from PostInitializeComponents()
+	 * Override to bind the channels your movement component registers
+	 */
+	virtual void BindSimulatedModifierLevels();
+	void BindSimulatedModifierLevel(const FGameplayTag& ModifierType, FSetSimulatedLevelFunc SetLevel);
+
 public:
+	/**
+	 * Called by UModifierMovement::DispatchModifierEvents() with the net change of a channel this tick
+	 * Replicates the level to simulated proxies and fires the modifier events
+	 */
+	virtual void NotifyModifierChannelChanged(int32 Channel, const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
+		const FGameplayTag& PrevModifierLevel, uint8 ModifierLevelValue, uint8 PrevModifierLevelValue);
+
 	template<typename T>
 	void NotifyModifierChanged(const FGameplayTag& ModifierType, const FGameplayTag& ModifierLevel,
 		const FGameplayTag& PrevModifierLevel, T ModifierLevelValue, T PrevModifierLevelValue, T InvalidLevel)
@@ -90,6 +113,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Boost"))
 	virtual bool Boost(FGameplayTag Level, EModifierNetType NetType);
 
+	/**
+	 * Request the character to start Boost, which is removed after Duration without requiring a correction.
+	 * Client and server expire it against the same move timestamp.
+	 * @param Level The level of the Boost to add.
+	 * @param NetType How the Boost is applied, either locally predicted, with correction, or server initiated.
+	 * @param Duration How long the Boost lasts, in seconds.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Boost"))
+	virtual bool BoostForDuration(FGameplayTag Level, EModifierNetType NetType, float Duration);
+
+	/**
+	 * Schedule a ServerInitiated Boost to start slightly in the future, which the client applies on the same move as the
+	 * server without requiring a correction. Server only.
+	 * @param Level The level of the Boost to add.
+	 * @param Duration If above zero, how long the Boost lasts, in seconds.
+	 * @see UModifierMovement::ScheduleModifier
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Character, meta=(GameplayTagFilter="Modifier.Boost"))
+	virtual bool ScheduleBoost(FGameplayTag Level, float Duration=0.f);
+
 	/**
 	 * Request the character to stop Boost. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the Boost to remove.
@@ -142,6 +185,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Snare"))
 	virtual bool Snare(FGameplayTag Level);
 
+	/**
+	 * Request the character to start Snare, which is removed after Duration without requiring a correction.
+	 * The expiry is sent to the client with the correction that applies the Snare, and both sides expire it against
+	 * the same move timestamp.
+	 * @param Level The level of the Snare to add.
+	 * @param Duration How long the Snare lasts, in seconds.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.Snare"))
+	virtual bool SnareForDuration(FGameplayTag Level, float Duration);
+
+	/**
+	 * Schedule a Snare to start slightly in the future, which the client applies on the same move as the server without
+	 * requiring a correction. Server only.
+	 * @param Level The level of the Snare to add.
+	 * @param Duration If above zero, how long the Snare lasts, in seconds.
+	 * @see UModifierMovement::ScheduleModifier
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Character, meta=(GameplayTagFilter="Modifier.Snare"))
+	virtual bool ScheduleSnare(FGameplayTag Level, float Duration=0.f);
+
 	/**
 	 * Request the character to stop Modified. The request is processed on the next update of the CharacterMovementComponent.
 	 * @see OnEndModifier
@@ -192,6 +255,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.SlowFall"))
 	virtual bool SlowFall(FGameplayTag Level);
 
+	/**
+	 * Request the character to start SlowFall, which is removed after Duration.
+	 * @param Level The level of the SlowFall to add.
+	 * @param Duration How long the SlowFall lasts, in seconds.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Character, meta=(GameplayTagFilter="Modifier.SlowFall"))
+	virtual bool SlowFallForDuration(FGameplayTag Level, float Duration);
+
 	/**
 	 * Request the character to stop SlowFall. The request is processed on the next update of the CharacterMovementComponent.
 	 * @param Level The level of the SlowFall to remove.
@@ -8,7 +8,176 @@
 
 // UINT8_MAX is NO_MODIFIER, so UINT8_MAX-1 is the max for uint8 -- NO_MODIFIER is defined in ModifierTypes.h
 using TModSize = uint8;  // If you want more than 254 modifiers, change this to uint16 or uint32
-using TModifierStack = TArray<TModSize>;
+
+/**
+ * Number of modifiers a stack holds inline before spilling to the heap
+ * Matches the default MaxBoosts, MaxSnares, MaxSlowFalls and MaxSerializedModifiers, raise it if you raise those caps
+ * Every saved move, network move and move response holds several stacks, so these must not allocate per move
+ */
+#ifndef MODIFIER_STACK_INLINE_CAPACITY
+#define MODIFIER_STACK_INLINE_CAPACITY 8
+#endif
+
+using TModifierStack = TArray<TModSize, TInlineAllocator<MODIFIER_STACK_INLINE_CAPACITY>>;
+
+/**
+ * A wanted modifier that is removed once the move timestamp reaches ExpiryTimestamp
+ * Client and server expire it against the same client move timestamp, so expiry doesn't cause a correction
+ * @see FMovementModifier::AddTimedModifier()
+ */
+struct PREDICTEDMOVEMENT_API FModifierTimer
+{
+	TModSize Level = NO_MODIFIER;
+	float ExpiryTimestamp = 0.f;
+
+	bool operator==(const FModifierTimer& Other) const
+	{
+		return Level == Other.Level && ExpiryTimestamp == Other.ExpiryTimestamp;
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FModifierTimer& Timer)
+	{
+		Ar << Timer.Level;
+		Ar << Timer.ExpiryTimestamp;
+		return Ar;
+	}
+};
+
+using TModifierTimers = TArray<FModifierTimer, TInlineAllocator<MODIFIER_STACK_INLINE_CAPACITY>>;
+
+/**
+ * A ServerInitiated modifier the server will add once the client move timestamp reaches StartTimestamp
+ * Sent to the client ahead of time with every move response, so both sides add it on the same move without a correction
+ * @see UModifierMovement::ScheduleModifier()
+ */
+struct PREDICTEDMOVEMENT_API FModifierSchedule
+{
+	/** Sequence number, so the client can ignore schedules it already received */
+	uint16 Id = 0;
+
+	TModSize Level = NO_MODIFIER;
+	float StartTimestamp = 0.f;
+
+	/** If above zero the modifier is timed, expiring Duration after StartTimestamp, see FModifierTimer */
+	float Duration = 0.f;
+
+	friend FArchive& operator<<(FArchive& Ar, FModifierSchedule& Schedule)
+	{
+		Ar << Schedule.Id;
+		Ar << Schedule.Level;
+		Ar << Schedule.StartTimestamp;
+		Ar << Schedule.Duration;
+		return Ar;
+	}
+};
+
+using TModifierSchedules = TArray<FModifierSchedule, TInlineAllocator<4>>;
+
+/**
+ * Running aggregates over a set of modifier levels, enough to resolve any EModifierLevelMethod without storing the levels
+ */
+struct PREDICTEDMOVEMENT_API FModifierLevelAggregate
+{
+	/** Total number of modifiers */
+	int32 NumModifiers = 0;
+
+	/** Sum of all levels */
+	uint32 LevelSum = 0;
+
+	/** Lowest and highest level added, NO_MODIFIER if empty */
+	TModSize MinLevel = NO_MODIFIER;
+	TModSize MaxLevel = NO_MODIFIER;
+
+	bool IsEmpty() const { return NumModifiers == 0; }
+	int32 Num() const { return NumModifiers; }
+
+	/** Level as if every modifier was stacked, e.g. a level 1 and a level 4 modifier gives level 5 (0-based) */
+	uint32 GetStackedLevel() const { return NumModifiers > 0 ? LevelSum + NumModifiers - 1 : 0; }
+
+	/** Average level, rounded down */
+	TModSize GetAverageLevel() const { return NumModifiers > 0 ? static_cast<TModSize>(LevelSum / NumModifiers) : 0; }
+
+	void Add(TModSize Level)
+	{
+		NumModifiers++;
+		LevelSum += Level;
+		MinLevel = MinLevel == NO_MODIFIER ? Level : FMath::Min(MinLevel, Level);
+		MaxLevel = MaxLevel == NO_MODIFIER ? Level : FMath::Max(MaxLevel, Level);
+	}
+
+	void Reset()
+	{
+		NumModifiers = 0;
+		LevelSum = 0;
+		MinLevel = NO_MODIFIER;
+		MaxLevel = NO_MODIFIER;
+	}
+};
+
+/** Number of levels a FModifierLevelCounts holds inline before spilling to the heap */
+#ifndef MODIFIER_LEVEL_INLINE_CAPACITY
+#define MODIFIER_LEVEL_INLINE_CAPACITY 8
+#endif
+
+/**
+ * Per-level histogram of a modifier stack, with running aggregates
+ * The ordered stack remains the source of truth for which entries are applied, this only answers level queries without walking it
+ */
+struct PREDICTEDMOVEMENT_API FModifierLevelCounts : FModifierLevelAggregate
+{
+	using Super = FModifierLevelAggregate;
+
+	/** Number of modifiers at each level, indexed by level */
+	TArray<uint16, TInlineAllocator<MODIFIER_LEVEL_INLINE_CAPACITY>> Counts;
+
+	uint16 GetNum(TModSize Level) const { return Counts.IsValidIndex(Level) ? Counts[Level] : 0; }
+	bool Contains(TModSize Level) const { return GetNum(Level) > 0; }
+
+	void Add(TModSize Level);
+
+	/**
+	 * Removes modifiers of the specified level
+	 * @param Level The level to remove
+	 * @param Count Number to remove, clamped to the number present
+	 */
+	void Remove(TModSize Level, int32 Count = 1);
+
+	void Reset();
+
+	/** Rebuild from an ordered stack, used when the stack is replaced wholesale */
+	void Rebuild(const TModifierStack& Stack);
+};
+
+/**
+ * Resolves a level from FModifierLevelAggregate for a level method known at compile time
+ * Used by the templated FModifierStatics functions so fixed-method channels have no runtime switch
+ */
+template<EModifierLevelMethod Method>
+struct TModifierLevelPolicy;
+
+template<>
+struct TModifierLevelPolicy<EModifierLevelMethod::Max>
+{
+	static uint32 GetLevel(const FModifierLevelAggregate& Levels) { return Levels.MaxLevel; }
+};
+
+template<>
+struct TModifierLevelPolicy<EModifierLevelMethod::Min>
+{
+	static uint32 GetLevel(const FModifierLevelAggregate& Levels) { return Levels.MinLevel; }
+};
+
+template<>
+struct TModifierLevelPolicy<EModifierLevelMethod::Stack>
+{
+	static uint32 GetLevel(const FModifierLevelAggregate& Levels) { return Levels.GetStackedLevel(); }
+};
+
+template<>
+struct TModifierLevelPolicy<EModifierLevelMethod::Average>
+{
+	static uint32 GetLevel(const FModifierLevelAggregate& Levels) { return Levels.GetAverageLevel(); }
+};
 
 /**
  * FSavedMove_Character
@@ -17,6 +186,9 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove
 {
 	TModifierStack WantsModifiers;
 
+	/** The wanted stack at the start of a combined move that switches to WantsModifiers part way through */
+	TModifierStack StartWantsModifiers;
+
 	FModifierSavedMove()
 	{}
 	
@@ -25,6 +197,7 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove
 	virtual void Clear()
 	{
 		WantsModifiers.Empty();
+		StartWantsModifiers.Empty();
 	}
 
 	void SetMoveFor(const TModifierStack& Modifiers)
@@ -57,6 +230,14 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove_WithCorrection final : FModifier
 	
 	TModifierStack Modifiers;
 
+	/**
+	 * The stack the server received with this move, fixed when the move is first sent
+	 * Modifiers is rewritten afterward by replays and state-only corrections, so corrections that omit the stack restore
+	 * it from here, see FModifierMoveResponseDataContainer::RestoreClientModifiers()
+	 */
+	mutable TModifierStack SentModifiers;
+	mutable bool bSent = false;
+
 	FModifierSavedMove_WithCorrection()
 	{}
 
@@ -64,12 +245,25 @@ struct PREDICTEDMOVEMENT_API FModifierSavedMove_WithCorrection final : FModifier
 	{
 		Super::Clear();
 		Modifiers.Empty();
+		SentModifiers.Empty();
+		bSent = false;
 	}
 
 	void PostUpdate(const TModifierStack& InModifiers)
 	{
 		Modifiers = InModifiers;
 	}
+
+	/** @return The stack to send with this move, the same one each time the move is resent */
+	const TModifierStack& MarkSent() const
+	{
+		if (!bSent)
+		{
+			SentModifiers = Modifiers;
+			bSent = true;
+		}
+		return SentModifiers;
+	}
 };
 
 /**
@@ -101,10 +295,59 @@ struct PREDICTEDMOVEMENT_API FModifierMoveResponse
 {
 	TModifierStack Modifiers;
 
+	/** Expiry of the timed modifiers, only sent for ServerInitiated modifiers as the client has no other way to know them */
+	TModifierTimers Timers;
+
+	/** Scheduled ServerInitiated modifiers that haven't started yet, sent with acks as well as corrections */
+	TModifierSchedules Schedules;
+
+	/**
+	 * Set by the server when Modifiers matches the stack the client sent for the corrected move, so only this bit is
+	 * sent and the client restores Modifiers from the stack it sent, see FModifierSavedMove_WithCorrection::SentModifiers
+	 */
+	bool bMatchesClient = false;
+
 	void ServerFillResponseData(const TModifierStack& InModifiers)
 	{
 		Modifiers = InModifiers;
 	}
+
+	void ServerFillResponseData(const TModifierStack& InModifiers, const TModifierTimers& InTimers)
+	{
+		Modifiers = InModifiers;
+		Timers = InTimers;
+	}
+};
+
+/**
+ * Server record of the last stack sent to the client in a correction, see UModifierMovement::ServerCheckClientError()
+ * Moves the client made before receiving it still carry the old stack, and aren't corrected again
+ */
+struct PREDICTEDMOVEMENT_API FModifierPendingCorrection
+{
+	TModifierStack Modifiers;
+
+	/** Client timestamp of the move the correction was sent for */
+	float Timestamp = 0.f;
+
+	/** Cleared once a client move carries the corrected stack */
+	bool bPending = false;
+
+	/**
+	 * Sent with an ack, see UModifierMovement::bUseStateOnlyCorrections
+	 * The client ignores it for a stack it changed since, so if the client still disagrees once it arrived, a full
+	 * correction is sent instead
+	 */
+	bool bStateOnly = false;
+};
+
+/** A channel whose level changed since its events were last dispatched, see UModifierMovement::DispatchModifierEvents() */
+struct PREDICTEDMOVEMENT_API FModifierPendingEvent
+{
+	/** Level before the first change */
+	TModSize PrevLevel = NO_MODIFIER;
+
+	bool bPending = false;
 };
 
 /**
@@ -139,6 +382,9 @@ struct PREDICTEDMOVEMENT_API FModifierMoveData_WithCorrection
 	TModifierStack WantsModifiers;
 	TModifierStack Modifiers;
 
+	/** Only sent when the wanted stack changes part way through the move, see FModifierStatics::QuantizeSubMoveAlpha() */
+	TModifierStack StartWantsModifiers;
+
 	void ClientFillNetworkMoveData(const TModifierStack& InWantsModifiers, const TModifierStack& InModifiers)
 	{
 		WantsModifiers = InWantsModifiers;
@@ -173,20 +419,81 @@ struct PREDICTEDMOVEMENT_API FModifierMoveData_ServerInitiated
  */
 struct PREDICTEDMOVEMENT_API FMovementModifier
 {
-	/** The requested input state, which requests modifiers of the specified level */
+	/**
+	 * The requested input state, which requests modifiers of the specified level
+	 * Use SetWantsModifiers() when replacing it, so that WantsCounts and WantsGeneration stay in sync
+	 */
 	TModifierStack WantsModifiers;
 	
 	/** The actual state, which represents the actual modifiers applied to the character */
 	TModifierStack Modifiers;
+
+	/** Per-level counts of WantsModifiers */
+	FModifierLevelCounts WantsCounts;
+
+	/** Per-level counts of Modifiers */
+	FModifierLevelCounts ModifierCounts;
+
+	/** Incremented whenever WantsModifiers changes, so the channel can skip evaluation when nothing did */
+	uint32 WantsGeneration = 0;
+
+	/** Expiry of the timed entries of WantsModifiers, in the order they were added */
+	TModifierTimers Timers;
+
+	/** Modifiers to add once the move timestamp reaches their start, in the order they were scheduled */
+	TModifierSchedules Schedules;
+
+	/**
+	 * Max number of entries WantsModifiers holds, adding more drops the oldest
+	 * Set to the channel's registered max by FModifierRegistry::InitNetLimits(), which is also the number serialized,
+	 * so client and server drop the same entries and the stack never grows past what is sent
+	 */
+	int32 MaxWantsModifiers = NO_MODIFIER - 1;
 	
 	/**
-	 * Adds a modifier to the stack
+	 * Adds a modifier to the stack, dropping the oldest if it already holds MaxWantsModifiers
 	 * @param Level The level of the modifier to add
 	 * @return True if the modifier was added
 	 */
 	bool AddModifier(TModSize Level)
 	{
+		if (MaxWantsModifiers <= 0)
+		{
+			return false;
+		}
+
+		const bool bFull = WantsModifiers.Num() >= MaxWantsModifiers;
+		if (bFull)
+		{
+			WantsCounts.Remove(WantsModifiers[0]);
+			WantsModifiers.RemoveAt(0, 1, EAllowShrinking::No);
+		}
+
 		WantsModifiers.Add(Level);
+		WantsCounts.Add(Level);
+		WantsGeneration++;
+
+		if (bFull)
+		{
+			TrimTimers();
+		}
+		return true;
+	}
+
+	/**
+	 * Adds a modifier to the stack that is removed once the move timestamp reaches ExpiryTimestamp
+	 * @param Level The level of the modifier to add
+	 * @param ExpiryTimestamp The move timestamp to remove it at, see UModifierMovement::GetTimestamp()
+	 * @return True if the modifier was added
+	 */
+	bool AddTimedModifier(TModSize Level, float ExpiryTimestamp)
+	{
+		Timers.Add({ Level, ExpiryTimestamp });
+		if (!AddModifier(Level))
+		{
+			Timers.Pop(EAllowShrinking::No);
+			return false;
+		}
 		return true;
 	}
 
@@ -198,16 +505,19 @@ struct PREDICTEDMOVEMENT_API FMovementModifier
 	 */
 	bool RemoveModifier(TModSize Level, bool bRemoveAll)
 	{
-		if (WantsModifiers.Contains(Level))
+		if (WantsCounts.Contains(Level))
 		{
 			if (bRemoveAll)
 			{
-				WantsModifiers.Remove(Level);
+				WantsCounts.Remove(Level, WantsModifiers.Remove(Level));
 			}
 			else
 			{
 				WantsModifiers.RemoveSingle(Level);
+				WantsCounts.Remove(Level);
 			}
+			WantsGeneration++;
+			TrimTimers();
 			return true;
 		}
 		return false;
@@ -222,11 +532,87 @@ struct PREDICTEDMOVEMENT_API FMovementModifier
 		if (WantsModifiers.Num() > 0)
 		{
 			WantsModifiers.Reset();
+			WantsCounts.Reset();
+			WantsGeneration++;
+			Timers.Reset();
+			Schedules.Reset();
 			return true;
 		}
 		return false;
 	}
 
+	/**
+	 * Replaces the requested input state, e.g. from a saved move, network move or correction
+	 * Timers are kept, as the stack is often replaced temporarily, e.g. while combining or replaying moves
+	 */
+	void SetWantsModifiers(const TModifierStack& InWantsModifiers)
+	{
+		if (WantsModifiers != InWantsModifiers)
+		{
+			WantsModifiers = InWantsModifiers;
+			WantsCounts.Rebuild(WantsModifiers);
+			WantsGeneration++;
+		}
+	}
+
+	/** Replaces the timers, e.g. from a correction, see TrimTimers() */
+	void SetTimers(const TModifierTimers& InTimers)
+	{
+		Timers = InTimers;
+		TrimTimers();
+	}
+
+	/**
+	 * Removes the timed modifiers that expired at or before Timestamp
+	 * @return True if any modifiers were removed
+	 */
+	bool ExpireModifiers(float Timestamp);
+
+	/**
+	 * Adds the scheduled modifiers that start at or before Timestamp
+	 * @return True if any modifiers were added
+	 */
+	bool StartScheduledModifiers(float Timestamp);
+
+	/**
+	 * Merges schedules received from the server, ignoring those already received
+	 * @param InSchedules The server's pending schedules
+	 * @param LastScheduleId The newest schedule received so far, updated
+	 */
+	void ReceiveSchedules(const TModifierSchedules& InSchedules, uint16& LastScheduleId);
+
+	/** Replaces the schedules, e.g. from a correction, including any already started as the corrected state predates them */
+	void SetSchedules(const TModifierSchedules& InSchedules, uint16& LastScheduleId)
+	{
+		Schedules = InSchedules;
+		for (const FModifierSchedule& Schedule : Schedules)
+		{
+			if (static_cast<int16>(Schedule.Id - LastScheduleId) > 0)
+			{
+				LastScheduleId = Schedule.Id;
+			}
+		}
+	}
+
+	/** Offsets every expiry and scheduled start, used to follow the client timestamp when it is reset */
+	void RebaseTimers(float Offset)
+	{
+		for (FModifierTimer& Timer : Timers)
+		{
+			Timer.ExpiryTimestamp += Offset;
+		}
+		for (FModifierSchedule& Schedule : Schedules)
+		{
+			Schedule.StartTimestamp += Offset;
+		}
+	}
+
+	/**
+	 * Drops the oldest timers of any level that has more timers than wanted modifiers, e.g. after it was removed early
+	 * Otherwise the leftover timer would later remove a modifier of the same level that was added without a duration
+	 */
+	void TrimTimers();
+
 	/**
 	 * Returns the number of wanted modifiers in the stack that match the specified level
 	 * This is the requested modifiers, not the actual modifiers applied to the character
@@ -244,12 +630,22 @@ struct PREDICTEDMOVEMENT_API FMovementModifier
 	TModSize GetNumModifiersByLevel(TModSize Level) const;
 
 	/**
-	 * Limits the number of modifiers in the stack to the specified maximum
+	 * Limits the number of modifiers applied from a stack to the specified maximum, the oldest are left out
 	 * Supports limiting between different types of modifiers affecting the same type of movement, e.g. BoostLocal and BoostCorrection
+	 * Nothing is removed from the stack, the applied modifiers are a window over its newest entries, so an entry left out
+	 * applies again once newer ones are removed, and client and server window the same entries of the same stack
+	 * The stack itself holds at most MaxWantsModifiers, which bounds how far back the window can reach
+	 * @param NumModifiers The number of modifiers in the stack
+	 * @param RemainingModifiers The budget left in the channel, reduced by the number applied
+	 * @return The number of modifiers to apply, counted from the end of the stack
 	 */
-	static void LimitNumModifiers(TModifierStack& Modifiers, int32& RemainingModifiers);
+	static int32 LimitNumModifiers(int32 NumModifiers, int32& RemainingModifiers);
 
-	/** Applies WantsModifiers to Modifiers based on the current state of the character */
+	/**
+	 * Applies WantsModifiers to Modifiers based on the current state of the character
+	 * Modifiers is updated in place, keeping the newest entries of WantsModifiers that fit within Remaining
+	 * @return True if Modifiers changed
+	 */
 	bool UpdateMovementState(bool bAllowedInCurrentState, bool bClampMax, int32& Remaining);
 };
 
@@ -265,12 +661,12 @@ struct PREDICTEDMOVEMENT_API FMovementModifier_LocalPredicted : FMovementModifie
 
 	void ServerMove_PerformMovement(const TModifierStack& InWantsModifiers)
 	{
-		WantsModifiers = InWantsModifiers;
+		SetWantsModifiers(InWantsModifiers);
 	}
 
 	void CombineWith(const TModifierStack& InWantsModifiers)
 	{
-		WantsModifiers = InWantsModifiers;
+		SetWantsModifiers(InWantsModifiers);
 	}
 };
 
@@ -293,7 +689,111 @@ struct PREDICTEDMOVEMENT_API FMovementModifier_WithCorrection final : FMovementM
 
 	void OnClientCorrectionReceived(const TModifierStack& InModifiers)
 	{
-		WantsModifiers = InModifiers;
+		SetWantsModifiers(InModifiers);
+	}
+};
+
+/**
+ * Combined params of every active modifier, e.g. Boost x Snare, cached so movement queries don't recombine them
+ * Recomputed only when a modifier level changes
+ */
+struct PREDICTEDMOVEMENT_API FModifierEffectiveParams
+{
+	/** Product of the active movement modifier scalars, indexed by EModifierParam */
+	FModifierParamVector Movement;
+
+	/** True if any active movement modifier affects root motion */
+	bool bAffectsRootMotion = false;
+
+	/** Product of the MaxWalkSpeed scalars of the active modifiers that affect root motion */
+	float RootMotionTranslationScalar = 1.f;
+
+	/** Params of the active falling modifier, nullptr if none */
+	const FFallingModifierParams* Falling = nullptr;
+
+	/** Gravity scalar of the active falling modifier, unless it is driven by fall velocity */
+	float GravityScalar = 1.f;
+
+	/** If true, GravityScalar must be evaluated from Falling based on the current velocity */
+	bool bGravityScalarFromVelocityZ = false;
+
+	void Reset()
+	{
+		*this = FModifierEffectiveParams();
+	}
+
+	/** Combine the params of a movement modifier's active level, e.g. Boost */
+	void AddMovement(const FMovementModifierParams& LevelParams)
+	{
+		Movement *= LevelParams.ToVector();
+
+		// Root motion
+		if (LevelParams.bAffectsRootMotion)
+		{
+			RootMotionTranslationScalar *= LevelParams.MaxWalkSpeed;
+			bAffectsRootMotion = true;
+		}
+	}
+
+	/** Combine the params of a falling modifier's active level, e.g. SlowFall -- only the first one added is in effect */
+	void AddFalling(const FFallingModifierParams& LevelParams, const FVector& Velocity)
+	{
+		if (!Falling)
+		{
+			Falling = &LevelParams;
+			bGravityScalarFromVelocityZ = LevelParams.bGravityScalarFromVelocityZ && LevelParams.GravityScalarFallVelocityCurve;
+			GravityScalar = bGravityScalarFromVelocityZ ? 1.f : LevelParams.GetGravityScalar(Velocity);
+		}
+	}
+};
+
+/**
+ * Inputs of the last evaluation of a modifier channel, e.g. Boost, used to skip evaluating it when nothing changed
+ * The channel is re-evaluated when a wanted stack changes, when its CanXInCurrentState result changes (movement mode,
+ * physics simulation, etc.), or when it is explicitly marked dirty, e.g. after a correction
+ */
+struct PREDICTEDMOVEMENT_API FModifierChannelDirtyState
+{
+	/** Combined WantsGeneration of the channel's modifiers at the last evaluation */
+	uint32 Generation = 0;
+
+	/** Result of CanActivateCallback at the last evaluation */
+	bool bCanActivate = false;
+
+	/** Forces the next evaluation */
+	bool bDirty = true;
+
+	void MarkDirty() { bDirty = true; }
+};
+
+/**
+ * A modifier's params baked into flat tables indexed by level, see FModifierStatics::BakeModifierLevels()
+ * Immutable once baked, and shared by every movement component using the same UModifierMovementConfig
+ */
+template<typename T>
+struct TModifierLevelTable
+{
+	/** Level tags, indexed by level */
+	TArray<FGameplayTag> Levels;
+
+	/** Params, indexed by level */
+	TArray<T> Params;
+
+	/** Level index for each level tag */
+	TMap<FGameplayTag, uint8> Indices;
+
+	/** Heap used by the table, including curves baked into its params */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = sizeof(*this) + Levels.GetAllocatedSize() + Params.GetAllocatedSize() + Indices.GetAllocatedSize();
+		if constexpr (std::is_same_v<T, FFallingModifierParams>)
+		{
+			for (const T& LevelParams : Params)
+			{
+				Size += LevelParams.GravityScalarFallVelocityTable.Samples.GetAllocatedSize();
+			}
+		}
+		return Size;
 	}
 };
 
@@ -312,6 +812,101 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	 */
 	static bool NetSerialize(TModifierStack& Modifiers, FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedModifiers=8);
 
+	/**
+	 * Serializes the modifier stack bit packed to the range of its channel, ceil(log2(NumLevels)) bits per level and
+	 * ceil(log2(MaxSerializedModifiers + 1)) bits for the count, run-length encoding repeated levels when that is smaller
+	 * Both sides must agree on NumLevels and MaxSerializedModifiers, see FModifierRegistry::NetSerializeStack()
+	 * @param Modifiers The modifier stack to serialize, the newest are kept if it exceeds MaxSerializedModifiers
+	 * @param Ar The archive to serialize to
+	 * @param ErrorName The name of the Modifier to report if serialization fails
+	 * @param NumLevels The number of levels of the channel, levels are indices below it
+	 * @param MaxSerializedModifiers The maximum number of modifiers to serialize, usually the channel's MaxModifiers
+	 * @return True if serialization was successful, false otherwise, including when a level or loaded count is out of range
+	 */
+	static bool NetSerializePacked(TModifierStack& Modifiers, FArchive& Ar, const FString& ErrorName, int32 NumLevels,
+		int32 MaxSerializedModifiers);
+
+	/**
+	 * Serializes the timers of a modifier to the archive
+	 * @param Timers The timers to serialize
+	 * @param Ar The archive to serialize to
+	 * @param ErrorName The name of the Modifier to report if serialization fails
+	 * @param MaxSerializedTimers The maximum number of timers to serialize, the newest are kept (default is 8)
+	 * @return True if serialization was successful, false otherwise
+	 */
+	static bool NetSerialize(TModifierTimers& Timers, FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedTimers=8);
+
+	/**
+	 * Serializes the pending schedules of a modifier to the archive
+	 * @param Schedules The schedules to serialize
+	 * @param Ar The archive to serialize to
+	 * @param ErrorName The name of the Modifier to report if serialization fails
+	 * @param MaxSerializedSchedules The maximum number of schedules to serialize, the oldest are kept as they start first
+	 * @return True if serialization was successful, false otherwise
+	 */
+	static bool NetSerialize(TModifierSchedules& Schedules, FArchive& Ar, const FString& ErrorName, uint8 MaxSerializedSchedules=4);
+
+	/**
+	 * Quantizes a point within a move to the fraction of the move sent to the server
+	 * Client and server both simulate from the quantized value, so they split the move at the same point
+	 * @param SubMoveTime Time since the start of the move
+	 * @param DeltaTime Duration of the move
+	 */
+	static uint8 QuantizeSubMoveAlpha(float SubMoveTime, float DeltaTime)
+	{
+		return DeltaTime > 0.f ? static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(SubMoveTime / DeltaTime * 255.f), 0, 255)) : 0;
+	}
+
+	/** @return Time since the start of the move of a point quantized by QuantizeSubMoveAlpha() */
+	static float GetSubMoveTime(uint8 SubMoveAlpha, float DeltaTime)
+	{
+		return DeltaTime * (SubMoveAlpha / 255.f);
+	}
+
+	/**
+	 * Bakes a modifier's tag-keyed params into flat tables indexed by level
+	 * If Levels is populated its order is kept, otherwise levels are taken from Params in insertion order
+	 * @param Params The params for each level tag, e.g. UModifierMovementConfig::Boost
+	 * @param Levels The level tags, indexed by level, e.g. UModifierMovementConfig::BoostLevels
+	 * @param Table Output tables; levels without params use the default params
+	 */
+	template<typename T>
+	static void BakeModifierLevels(const TMap<FGameplayTag, T>& Params, const TArray<FGameplayTag>& Levels,
+		TModifierLevelTable<T>& Table)
+	{
+		if (Levels.Num() > 0)
+		{
+			Table.Levels = Levels;
+		}
+		else
+		{
+			Params.GenerateKeyArray(Table.Levels);
+		}
+
+		// NO_MODIFIER is reserved, so that is the most levels we can index
+		if (!ensureMsgf(Table.Levels.Num() < NO_MODIFIER, TEXT("Too many modifier levels (%d), max is %d"), Table.Levels.Num(), NO_MODIFIER - 1))
+		{
+			Table.Levels.SetNum(NO_MODIFIER - 1);
+		}
+
+		Table.Params.Reset(Table.Levels.Num());
+		Table.Indices.Reset();
+		for (int32 Index = 0; Index < Table.Levels.Num(); Index++)
+		{
+			const T* LevelParam = Params.Find(Table.Levels[Index]);
+			Table.Params.Add(LevelParam ? *LevelParam : T());
+			Table.Indices.Add(Table.Levels[Index], static_cast<uint8>(Index));
+		}
+	}
+
+	/** An empty table, used by movement components until they bake their own */
+	template<typename T>
+	static const TSharedRef<const TModifierLevelTable<T>>& GetEmptyLevelTable()
+	{
+		static const TSharedRef<const TModifierLevelTable<T>> Empty = MakeShared<TModifierLevelTable<T>>();
+		return Empty;
+	}
+
 	/**
 	 * Updates the modifier level based on the specified method
 	 * @param Method The method to use for updating the modifier level
@@ -322,6 +917,29 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	 */
 	static TModSize UpdateModifierLevel(EModifierLevelMethod Method, const TModifierStack& Modifiers, TModSize MaxLevel, TModSize InvalidLevel);
 
+	/**
+	 * Updates the modifier level based on the specified method, in constant time from the running aggregates
+	 * @param Method The method to use for updating the modifier level
+	 * @param Counts The aggregates of the modifier stack, usually FMovementModifier::ModifierCounts
+	 * @param MaxLevel The maximum level of modifiers
+	 * @param InvalidLevel The level to return if no valid modifiers are found
+	 * @return The updated modifier level
+	 */
+	static TModSize UpdateModifierLevel(EModifierLevelMethod Method, const FModifierLevelAggregate& Counts, TModSize MaxLevel, TModSize InvalidLevel);
+
+	/** Compile-time equivalent of UpdateModifierLevel() for a fixed level method */
+	template<EModifierLevelMethod Method>
+	static TModSize UpdateModifierLevel(const FModifierLevelAggregate& Counts, TModSize MaxLevel, TModSize InvalidLevel)
+	{
+		if (Counts.IsEmpty())
+		{
+			return InvalidLevel;
+		}
+
+		// Clamp to max allowed
+		return static_cast<TModSize>(FMath::Min<uint32>(TModifierLevelPolicy<Method>::GetLevel(Counts), MaxLevel));
+	}
+
 	/**
 	 * Combines multiple modifier levels into a single level based on the specified method
 	 * @param Method The method to use for combining the modifier levels
@@ -340,11 +958,81 @@ struct PREDICTEDMOVEMENT_API FModifierStatics
 	 * @param bLimitMaxModifiers Whether to limit the maximum number of modifiers
 	 * @param MaxModifiers The maximum number of modifiers allowed
 	 * @param InvalidLevel The level to return if no valid modifiers are found
-	 * @param Modifiers The array of modifiers to process
-	 * @param CanActivateCallback Callback to determine if the modifier can be activated
+	 * @param Modifiers The modifiers to process, in priority order, e.g. a stack array of LocalPredicted -> WithCorrection -> ServerInitiated
+	 * @param CanActivateCallback Callback to determine if the modifiers can be activated, called once
 	 * @return True if the current level changed, false otherwise
 	 */
 	static bool ProcessModifiers(TModSize& CurrentLevel, EModifierLevelMethod Method, const TArray<FGameplayTag>& LevelTags,
-		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,	const TArray<FMovementModifier*>& Modifiers,
+		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,	TArrayView<FMovementModifier* const> Modifiers,
+		const TFunctionRef<bool()>& CanActivateCallback);
+
+	/**
+	 * Processes modifiers as above, with the level method dispatched once for the whole channel
+	 * @param bCanActivate Whether the modifiers can be activated in the current state
+	 */
+	static bool ProcessModifierLevels(TModSize& CurrentLevel, EModifierLevelMethod Method, const TArray<FGameplayTag>& LevelTags,
+		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers,
+		bool bCanActivate);
+
+	/**
+	 * Processes modifiers with a level method fixed at compile time, so there is no dispatch at all
+	 * Matches FModifierChannelDef::FProcessLevelsFunc, registered channels are bound to it, see FModifierRegistry::BindLevelPolicy()
+	 */
+	template<EModifierLevelMethod Method>
+	static bool ProcessModifierLevels(TModSize& CurrentLevel, const TArray<FGameplayTag>& LevelTags,
+		bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers,
+		bool bCanActivate);
+
+	/**
+	 * Whether a channel needs processing, i.e. an input changed since the last time DirtyState was processed
+	 * A channel with nothing wanted and nothing applied is skipped without querying CanActivateCallback at all
+	 * DirtyState.bCanActivate holds the result of CanActivateCallback when this returns true
+	 */
+	static bool UpdateDirtyState(FModifierChannelDirtyState& DirtyState, TArrayView<FMovementModifier* const> Modifiers,
 		const TFunctionRef<bool()>& CanActivateCallback);
-};
\ No newline at end of file
+
+	/**
+	 * Processes modifiers as above, but only if an input changed since the last time DirtyState was processed
+	 * A channel with nothing wanted and nothing applied is skipped without querying CanActivateCallback at all
+	 * @param DirtyState The inputs of the last evaluation of this channel, updated when evaluated
+	 * @return True if the current level changed, false otherwise
+	 */
+	static bool ProcessModifiers(FModifierChannelDirtyState& DirtyState, TModSize& CurrentLevel, EModifierLevelMethod Method,
+		const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel,
+		TArrayView<FMovementModifier* const> Modifiers, const TFunctionRef<bool()>& CanActivateCallback);
+};
+
+template<EModifierLevelMethod Method>
+bool FModifierStatics::ProcessModifierLevels(TModSize& CurrentLevel, const TArray<FGameplayTag>& LevelTags,
+	bool bLimitMaxModifiers, int32 MaxModifiers, TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers,
+	bool bCanActivate)
+{
+	const TModSize PrevLevel = CurrentLevel;
+
+	// Determine the maximum level based on the available tags
+	const TModSize MaxLevel = LevelTags.Num() > 0 ? static_cast<TModSize>(LevelTags.Num() - 1) : 0;
+
+	// Track modifier data -- the per-modifier levels are combined as we go, so there is nothing to allocate
+	bool bStateChanged = false;
+	FModifierLevelAggregate Levels;
+	int32 Remaining = MaxModifiers;
+
+	// Iterate through all modifiers and update their state
+	for (FMovementModifier* Modifier : Modifiers)
+	{
+		// Track if any state changed
+		bStateChanged |= Modifier->UpdateMovementState(bCanActivate, bLimitMaxModifiers, Remaining);
+
+		// Always read and process the current modifier data
+		const TModSize NewLevel = UpdateModifierLevel<Method>(Modifier->ModifierCounts, MaxLevel, InvalidLevel);
+		if (NewLevel != InvalidLevel)
+		{
+			Levels.Add(NewLevel);
+		}
+	}
+
+	// Combine all active modifier levels
+	CurrentLevel = UpdateModifierLevel<Method>(Levels, MaxLevel, InvalidLevel);
+
+	return bStateChanged || CurrentLevel != PrevLevel;
+}
\ No newline at end of file
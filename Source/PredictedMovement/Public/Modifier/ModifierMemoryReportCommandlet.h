@@ -0,0 +1,28 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ModifierMemoryReportCommandlet.generated.h"
+
+/**
+ * Reports the memory used by the modifier config of UModifierMovement, per character
+ * Creates a crowd of movement components and compares each of them owning its params and level tables, as they did
+ * before UModifierMovementConfig, with them sharing their config
+ *
+ * Usage: -run=ModifierMemoryReport [-Count=1500] [-Overrides=0] [-Config=/Game/Path/To/Config.Config]
+ * -Count: Number of characters
+ * -Overrides: Number of characters that copy their config with UModifierMovement::GetMutableModifierConfig()
+ * -Config: Config asset to use, otherwise the class defaults are used
+ */
+UCLASS()
+class PREDICTEDMOVEMENT_API UModifierMemoryReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UModifierMemoryReportCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -5,12 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "ModifierImpl.h"
+#include "ModifierMovementConfig.h"
+#include "ModifierRegistry.h"
 #include "ModifierTypes.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "System/PredictedMovementVersioning.h"
 #include "ModifierMovement.generated.h"
 
 class AModifierCharacter;
+struct FModifierAgentConfig;
 
 using TMod_Local = FMovementModifier_LocalPredicted;
 using TMod_LocalCorrection = FMovementModifier_WithCorrection;
@@ -21,22 +24,31 @@ struct PREDICTEDMOVEMENT_API FModifierMoveResponseDataContainer : FCharacterMove
 	using Super = FCharacterMoveResponseDataContainer;
 
 	/*
-	 * Used by the server to send Modifier data to the client
+	 * Used by the server to send Modifier data to the client, indexed by registered modifier
 	 * LocalPredicted modifiers are not sent, as the server does not correct input states
 	 */
 	
-	FModifierMoveResponse BoostCorrection;
-	FModifierMoveResponse BoostServer;
-	FModifierMoveResponse SnareServer;
+	TModifierSlotArray<FModifierMoveResponse> Modifiers;
 
-	/** Tell the client how much location authority they have */
+	/** Tell the client how much location authority they have, sent quantized to 8 bits, see QuantizeClientAuthAlpha() */
 	float ClientAuthAlpha = 0.f;
 
-	/** No need to send the float if the client has no authority */
-	bool bHasClientAuthAlpha;
+	/** No need to send the alpha if the client has no authority */
+	bool bHasClientAuthAlpha = false;
+
+	/** Quantized to a byte, 0 and 1 are exact so full and no authority survive the round trip */
+	static uint8 QuantizeClientAuthAlpha(float Alpha) { return static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Alpha, 0.f, 1.f) * 255.f)); }
+	static float DequantizeClientAuthAlpha(uint8 Alpha) { return Alpha / 255.f; }
+
+	/** The ack carries the modifier stacks, as only they mismatched, see UModifierMovement::bUseStateOnlyCorrections */
+	bool bHasStateCorrection = false;
 
 	virtual void ServerFillResponseData(const UCharacterMovementComponent& CharacterMovement, const FClientAdjustment& PendingAdjustment) override;
 	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap) override;
+
+protected:
+	/** Client restores the stacks the server omitted because they matched, see FModifierMoveResponse::bMatchesClient */
+	void RestoreClientModifiers(UCharacterMovementComponent& CharacterMovement);
 };
 
 struct PREDICTEDMOVEMENT_API FModifierNetworkMoveData : FCharacterNetworkMoveData
@@ -48,16 +60,23 @@ public:
 	{}
 
 	/*
-	 * Used by the client to send Modifier data to the server
+	 * Used by the client to send Modifier data to the server, indexed by registered modifier
 	 * If local predicted, this data is based on player input, and the server will apply it
 	 * Otherwise, the server will compare the client and server data to know when to send a correction
+	 * Only the stacks required by each modifier's net type are serialized
 	 */
 	
-	FModifierMoveData_LocalPredicted BoostLocal;
-	FModifierMoveData_WithCorrection BoostCorrection;
-	FModifierMoveData_ServerInitiated BoostServer;
-	FModifierMoveData_ServerInitiated SnareServer;
-	FModifierMoveData_LocalPredicted SlowFallLocal;
+	TModifierSlotArray<FModifierMoveData_WithCorrection> Modifiers;
+
+	/** The wanted stacks changed part way through this combined move, at WantsChangeAlpha */
+	bool bHasWantsChange = false;
+	uint8 WantsChangeAlpha = 0;
+
+	/**
+	 * Move serialized before this one in the same packet, stacks that match it are sent as a single bit
+	 * The new move is always serialized first, so the pending and old moves use it, see FModifierNetworkMoveDataContainer
+	 */
+	const FModifierNetworkMoveData* Baseline = nullptr;
 	
 	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
 	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Ar, UPackageMap* PackageMap, ENetworkMoveType MoveType) override;
@@ -73,6 +92,9 @@ public:
 		NewMoveData = &MoveData[0];
 		PendingMoveData = &MoveData[1];
 		OldMoveData = &MoveData[2];
+
+		MoveData[1].Baseline = &MoveData[0];
+		MoveData[2].Baseline = &MoveData[0];
 	}
  
 private:
@@ -81,7 +103,10 @@ private:
 
 /**
  * Supports stackable modifiers such as Boost, Snare, and SlowFall.
- * Duplicate the implementations to add your own modifiers. Don't forget to do the same for the character class.
+ * Each modifier is declared as a channel in the ModifierRegistry, which processes, saves, serializes and corrects it.
+ * To add your own modifiers, add their properties and register their channel in your constructor, see
+ * UModifierMovement::UModifierMovement(), and their params to a UModifierMovementConfig subclass.
+ * Don't forget to add Boost() etc. equivalents to the character class.
  */
 UCLASS()
 class PREDICTEDMOVEMENT_API UModifierMovement : public UCharacterMovementComponent
@@ -95,12 +120,19 @@ private:
 
 public:
 	/**
-	 * Boost modifies movement properties such as speed and acceleration
-	 * Scaling applied on a per-Boost-level basis
+	 * Boost, Snare and SlowFall params and levels, and the client auth params, shared with every component using the
+	 * same config, the class defaults of UModifierMovementConfig are used if none is set
+	 * Call BakeModifierLevels() if you change this at runtime
 	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
-	TMap<FGameplayTag, FMovementModifierParams> Boost;
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
+	TObjectPtr<const UModifierMovementConfig> ModifierConfig;
 
+protected:
+	/** This component's own copy of the modifier config, made by GetMutableModifierConfig() */
+	UPROPERTY(Transient, DuplicateTransient)
+	TObjectPtr<UModifierMovementConfig> OwnedModifierConfig;
+
+public:
 	/**
 	 * Limits the maximum number of Boost levels that can be applied to the character
 	 * This value is shared between each type of Boost
@@ -119,9 +151,8 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxBoosts"))
 	int32 MaxBoosts = 8;
 
-	/** Indexed list of Boost levels, used to determine the current Boost level based on index */
-	UPROPERTY()
-	TArray<FGameplayTag> BoostLevels;
+	/** Boost levels and params of the modifier config, see BakeModifierLevels() */
+	TSharedRef<const TModifierLevelTable<FMovementModifierParams>> BoostLevelTable = FModifierStatics::GetEmptyLevelTable<FMovementModifierParams>();
 
 	/** The method used to calculate Boost levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
@@ -136,14 +167,8 @@ public:
 	/** Server Initiated Boost that is sent to the Client via a correction */
 	TMod_Server BoostServer;
 
-public:
-	/**
-	 * Snare modifies movement properties such as speed and acceleration
-	 * Scaling applied on a per-Snare-level basis
-	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
-	TMap<FGameplayTag, FMovementModifierParams> Snare;
 
+public:
 	/**
 	 * Limits the maximum number of Snare levels that can be applied to the character
 	 * This value is shared between each type of Snare
@@ -160,9 +185,8 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxSnares"))
 	int32 MaxSnares = 8;
 
-	/** Indexed list of Snare levels, used to determine the current Snare level based on index */
-	UPROPERTY()
-	TArray<FGameplayTag> SnareLevels;
+	/** Snare levels and params of the modifier config, see BakeModifierLevels() */
+	TSharedRef<const TModifierLevelTable<FMovementModifierParams>> SnareLevelTable = FModifierStatics::GetEmptyLevelTable<FMovementModifierParams>();
 
 	/** The method used to calculate Snare levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
@@ -171,14 +195,8 @@ public:
 	/** Server Initiated Snare that is sent to the Client via a correction */
 	TMod_Server SnareServer;
 
-public:
-	/**
-	 * SlowFall changes falling properties, such as gravity and air control
-	 * Scaling applied on a per-SlowFall-level basis
-	 */
-	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
-	TMap<FGameplayTag, FFallingModifierParams> SlowFall;
 
+public:
 	/**
 	 * Limits the maximum number of SlowFall levels that can be applied to the character
 	 * This value is shared between each type of SlowFall
@@ -197,9 +215,8 @@ public:
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin=1, UIMin=1, UIMax=32, EditCondition="bLimitMaxSlowFalls"))
 	int32 MaxSlowFalls = 8;
 
-	/** Indexed list of SlowFall levels, used to determine the current SlowFall level */
-	UPROPERTY()
-	TArray<FGameplayTag> SlowFallLevels;
+	/** SlowFall levels and params of the modifier config, see BakeModifierLevels() */
+	TSharedRef<const TModifierLevelTable<FFallingModifierParams>> SlowFallLevelTable = FModifierStatics::GetEmptyLevelTable<FFallingModifierParams>();
 
 	/** The method used to calculate SlowFall levels */
 	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite)
@@ -207,12 +224,9 @@ public:
 
 	/** Local Predicted SlowFall based on Player Input */
 	TMod_Local SlowFallLocal;
+
 	
 public:
-	/** Client auth parameters mapped to a source gameplay tag */
-	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly)
-	TMap<FGameplayTag, FClientAuthParams> ClientAuthParams;
-
 	UPROPERTY()
 	FClientAuthStack ClientAuthStack;
 
@@ -227,8 +241,52 @@ public:
 
 	virtual bool HasValidData() const override;
 	virtual void PostLoad() override;
+	virtual void OnRegister() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
 
+	/** @return The modifier config in use, this component's own copy if it has one, never null */
+	virtual const UModifierMovementConfig* GetModifierConfig() const;
+
+	/**
+	 * Copy the modifier config on first use so this component can change its params without affecting any other
+	 * Call BakeModifierLevels() once done changing it
+	 */
+	UModifierMovementConfig* GetMutableModifierConfig();
+
+	/**
+	 * Point at the level tables of the modifier config, called from OnRegister() in game worlds
+	 * Configs bake their tables when loaded, so this only re-bakes this component's own copy, if it has one
+	 * Call this again if you change the modifier params or levels at runtime
+	 * The number of levels and MaxModifiers sent over the network are fixed when the component registers, so levels can't
+	 * be added at runtime, and raising MaxModifiers only sends up to the registered max
+	 */
+	virtual void BakeModifierLevels();
+
+protected:
+	/** Point the registered channels at the current level tables */
+	void BindModifierLevelTables();
+
+public:
+	/**
+	 * Make modifier tuning for lightweight agents that don't have a movement component, e.g. crowds, sharing this
+	 * component's baked tables, level methods and max modifiers so the same tuning applies identically to both
+	 * Channels are in registration order, override to add the channels you register
+	 * Use GetModifierAgentConfig() rather than calling this directly, so agents share one config
+	 * @see FModifierAgentState
+	 */
+	virtual TSharedRef<const FModifierAgentConfig> MakeModifierAgentConfig() const;
+
+	/**
+	 * Modifier tuning for agents, made by MakeModifierAgentConfig() on first use and kept until BakeModifierLevels() runs
+	 * again, call that after changing level methods or max modifiers at runtime for new agents to use them
+	 */
+	TSharedRef<const FModifierAgentConfig> GetModifierAgentConfig() const;
+
+protected:
+	/** Made by GetModifierAgentConfig(), reset by BakeModifierLevels() */
+	mutable TSharedPtr<const FModifierAgentConfig> ModifierAgentConfig;
+
 public:
 	virtual float GetMaxAcceleration() const override;
 	virtual float GetMaxSpeed() const override;
@@ -239,6 +297,13 @@ public:
 	
 	virtual float GetGravityZ() const override;
 	virtual FVector GetAirControl(float DeltaTime, float TickAirControl, const FVector& FallAcceleration) override;
+	virtual FRotator GetDeltaRotation(float DeltaTime) const override;
+
+#if UE_5_05_OR_LATER
+	virtual bool DoJump(bool bReplayingMoves, float DeltaTime) override;
+#else
+	virtual bool DoJump(bool bReplayingMoves) override;
+#endif
 	
 	virtual void CalcVelocity(float DeltaTime, float Friction, bool bFluid, float BrakingDeceleration) override;
 	virtual void ApplyVelocityBraking(float DeltaTime, float Friction, float BrakingDeceleration) override;
@@ -248,17 +313,17 @@ public:
 
 	uint8 BoostLevel = NO_MODIFIER;
 	bool IsBoostActive() const { return BoostLevel != NO_MODIFIER; }
-	const FMovementModifierParams* GetBoostParams() const { return Boost.Find(GetBoostLevel()); }
-	FGameplayTag GetBoostLevel() const { return BoostLevels.IsValidIndex(BoostLevel) ? BoostLevels[BoostLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetBoostLevelIndex(const FGameplayTag& Level) const { return BoostLevels.IndexOfByKey(Level) > INDEX_NONE ? BoostLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FMovementModifierParams* GetBoostParams() const { return BoostLevelTable->Params.IsValidIndex(BoostLevel) ? &BoostLevelTable->Params[BoostLevel] : nullptr; }
+	FGameplayTag GetBoostLevel() const { return BoostLevelTable->Levels.IsValidIndex(BoostLevel) ? BoostLevelTable->Levels[BoostLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetBoostLevelIndex(const FGameplayTag& Level) const { const uint8* Index = BoostLevelTable->Indices.Find(Level); return Index ? *Index : NO_MODIFIER; }
 	virtual bool CanBoostInCurrentState() const;
 
-	float GetBoostSpeedScalar() const { return GetBoostParams() ? GetBoostParams()->MaxWalkSpeed : 1.f; }
-	float GetBoostAccelScalar() const { return GetBoostParams() ? GetBoostParams()->MaxAcceleration : 1.f; }
-	float GetBoostBrakingScalar() const { return GetBoostParams() ? GetBoostParams()->BrakingDeceleration : 1.f; }
-	float GetBoostGroundFrictionScalar() const { return GetBoostParams() ? GetBoostParams()->GroundFriction : 1.f; }
-	float GetBoostBrakingFrictionScalar() const { return GetBoostParams() ? GetBoostParams()->BrakingFriction : 1.f; }
-	bool BoostAffectsRootMotion() const { return GetBoostParams() ? GetBoostParams()->bAffectsRootMotion : false; }
+	float GetBoostSpeedScalar() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->MaxWalkSpeed : 1.f; }
+	float GetBoostAccelScalar() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->MaxAcceleration : 1.f; }
+	float GetBoostBrakingScalar() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->BrakingDeceleration : 1.f; }
+	float GetBoostGroundFrictionScalar() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->GroundFriction : 1.f; }
+	float GetBoostBrakingFrictionScalar() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->BrakingFriction : 1.f; }
+	bool BoostAffectsRootMotion() const { const FMovementModifierParams* Params = GetBoostParams(); return Params ? Params->bAffectsRootMotion : false; }
 	
 	/* ~Boost Implementation */
 
@@ -267,17 +332,17 @@ public:
 
 	uint8 SnareLevel = NO_MODIFIER;
 	bool IsSnareActive() const { return SnareLevel != NO_MODIFIER; }
-	const FMovementModifierParams* GetSnareParams() const { return Snare.Find(GetSnareLevel()); }
-	FGameplayTag GetSnareLevel() const { return SnareLevels.IsValidIndex(SnareLevel) ? SnareLevels[SnareLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetSnareLevelIndex(const FGameplayTag& Level) const { return SnareLevels.IndexOfByKey(Level) > INDEX_NONE ? SnareLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FMovementModifierParams* GetSnareParams() const { return SnareLevelTable->Params.IsValidIndex(SnareLevel) ? &SnareLevelTable->Params[SnareLevel] : nullptr; }
+	FGameplayTag GetSnareLevel() const { return SnareLevelTable->Levels.IsValidIndex(SnareLevel) ? SnareLevelTable->Levels[SnareLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetSnareLevelIndex(const FGameplayTag& Level) const { const uint8* Index = SnareLevelTable->Indices.Find(Level); return Index ? *Index : NO_MODIFIER; }
 	virtual bool CanSnareInCurrentState() const;
 
-	float GetSnareSpeedScalar() const { return GetSnareParams() ? GetSnareParams()->MaxWalkSpeed : 1.f; }
-	float GetSnareAccelScalar() const { return GetSnareParams() ? GetSnareParams()->MaxAcceleration : 1.f; }
-	float GetSnareBrakingScalar() const { return GetSnareParams() ? GetSnareParams()->BrakingDeceleration : 1.f; }
-	float GetSnareGroundFrictionScalar() const { return GetSnareParams() ? GetSnareParams()->GroundFriction : 1.f; }
-	float GetSnareBrakingFrictionScalar() const { return GetSnareParams() ? GetSnareParams()->BrakingFriction : 1.f; }
-	bool SnareAffectsRootMotion() const { return GetSnareParams() ? GetSnareParams()->bAffectsRootMotion : false; }
+	float GetSnareSpeedScalar() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->MaxWalkSpeed : 1.f; }
+	float GetSnareAccelScalar() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->MaxAcceleration : 1.f; }
+	float GetSnareBrakingScalar() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->BrakingDeceleration : 1.f; }
+	float GetSnareGroundFrictionScalar() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->GroundFriction : 1.f; }
+	float GetSnareBrakingFrictionScalar() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->BrakingFriction : 1.f; }
+	bool SnareAffectsRootMotion() const { const FMovementModifierParams* Params = GetSnareParams(); return Params ? Params->bAffectsRootMotion : false; }
 	
 	/* ~Snare Implementation */
 
@@ -286,20 +351,238 @@ public:
 
 	uint8 SlowFallLevel = NO_MODIFIER;
 	bool IsSlowFallActive() const { return SlowFallLevel != NO_MODIFIER; }
-	const FFallingModifierParams* GetSlowFallParams() const { return SlowFall.Find(GetSlowFallLevel()); }
-	FGameplayTag GetSlowFallLevel() const { return SlowFallLevels.IsValidIndex(SlowFallLevel) ? SlowFallLevels[SlowFallLevel] : FGameplayTag::EmptyTag; }
-	uint8 GetSlowFallLevelIndex(const FGameplayTag& Level) const { return SlowFallLevels.IndexOfByKey(Level) > INDEX_NONE ? SlowFallLevels.IndexOfByKey(Level) : NO_MODIFIER; }
+	const FFallingModifierParams* GetSlowFallParams() const { return SlowFallLevelTable->Params.IsValidIndex(SlowFallLevel) ? &SlowFallLevelTable->Params[SlowFallLevel] : nullptr; }
+	FGameplayTag GetSlowFallLevel() const { return SlowFallLevelTable->Levels.IsValidIndex(SlowFallLevel) ? SlowFallLevelTable->Levels[SlowFallLevel] : FGameplayTag::EmptyTag; }
+	uint8 GetSlowFallLevelIndex(const FGameplayTag& Level) const { const uint8* Index = SlowFallLevelTable->Indices.Find(Level); return Index ? *Index : NO_MODIFIER; }
 	virtual bool CanSlowFallInCurrentState() const;
 
-	virtual float GetSlowFallGravityZScalar() const { return GetSlowFallParams() ? GetSlowFallParams()->GetGravityScalar(Velocity) : 1.f; }
+	virtual float GetSlowFallGravityZScalar() const
+	{
+		return EffectiveModifierParams.bGravityScalarFromVelocityZ ?
+			EffectiveModifierParams.Falling->GetGravityScalar(Velocity) : EffectiveModifierParams.GravityScalar;
+	}
 	virtual bool RemoveVelocityZOnSlowFallStart() const;
 
 	/* ~SlowFall Implementation */
 
 public:
+	/**
+	 * How far ahead of the client's latest move ScheduleModifier() starts a modifier, as a multiple of the round trip time
+	 * The schedule has to reach the client before it simulates that timestamp, otherwise it falls back to a correction
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="3"))
+	float ScheduledModifierLeadScale = 1.f;
+
+	/** Added to the round trip time based lead of ScheduleModifier(), to absorb jitter */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="0.5", ForceUnits=s))
+	float ScheduledModifierLeadPadding = 0.05f;
+
+	/** Upper bound of the lead of ScheduleModifier(), so high latency clients aren't kept waiting */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", UIMin="0", UIMax="1", ForceUnits=s))
+	float MaxScheduledModifierLead = 0.5f;
+
+protected:
+	/** Sequence number of the last schedule, sent on the server and received on the client */
+	uint16 LastModifierScheduleId = 0;
+
+public:
+	/**
+	 * Schedule a ServerInitiated modifier to start at a client move timestamp slightly in the future
+	 * The schedule is sent with every move response until it starts, and both sides add it on the same move, so unlike
+	 * adding it directly no correction or replay is needed, provided it reaches the client in time
+	 * @param Modifier A ServerInitiated modifier, e.g. SnareServer
+	 * @param Level The level of the modifier to add
+	 * @param Duration If above zero, the modifier is removed after this long, see FMovementModifier::AddTimedModifier()
+	 * @return True if the modifier was scheduled
+	 */
+	bool ScheduleModifier(FMovementModifier& Modifier, TModSize Level, float Duration = 0.f);
+
+	/** How far ahead of the client's latest move to schedule modifiers, based on the round trip time */
+	virtual float GetScheduledModifierLead() const;
+
+public:
+	/**
+	 * If true, characters without an autonomous proxy, e.g. AI on a dedicated server, skip the modifier work that only
+	 * exists to predict and correct a client, see IsServerOnlyMovement()
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly)
+	bool bUseServerOnlyFastPath = true;
+
+	/**
+	 * True if only the server simulates this character, so there is no client to predict, verify or correct its modifiers
+	 * These characters evaluate their modifiers once per move, start scheduled modifiers without a lead, and ignore
+	 * client authority, which has no client to grant it to
+	 */
+	bool IsServerOnlyMovement() const;
+
+	/**
+	 * If true, a move whose position agrees with the server but whose modifier stacks don't is acked with the server's
+	 * stacks instead of being corrected, so the client applies them without rewinding and replaying its moves
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly)
+	bool bUseStateOnlyCorrections = true;
+
+	/**
+	 * How long after a modifier correction is sent to wait for the client to apply it before correcting it again, as a
+	 * multiple of the round trip time -- moves made before the client received it don't trigger further corrections
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly, meta=(ClampMin="0", UIMin="0", UIMax="3"))
+	float ModifierCorrectionAckScale = 1.f;
+
+	/** Added to the round trip time based wait of ModifierCorrectionAckScale, to absorb jitter */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly, meta=(ClampMin="0", UIMin="0", UIMax="0.5", ForceUnits=s))
+	float ModifierCorrectionAckPadding = 0.1f;
+
+	/**
+	 * Number of moves of modifier state the server keeps for lag compensated queries, see GetModifierHistory()
+	 * Allocated once when registered, 0 disables recording
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly, meta=(ClampMin="0", UIMin="0", UIMax="256"))
+	int32 ModifierHistorySize = 64;
+
+protected:
+	/** Set by ServerCheckClientError() when the last move only mismatched modifier stacks, sent with the next ack */
+	bool bPendingStateCorrection = false;
+
+	/** Stacks sent to the client that it hasn't applied yet, indexed by registered modifier */
+	TModifierSlotArray<FModifierPendingCorrection> PendingCorrections;
+
+	/**
+	 * Stacks the client reported with its last checked move, indexed by registered modifier
+	 * Stacks of a correction that still match are omitted, see FModifierMoveResponse::bMatchesClient
+	 */
+	TModifierSlotArray<TModifierStack> ClientReportedModifiers;
+
+	/** Client timestamp of the move ClientReportedModifiers was recorded from */
+	float ClientReportedTimestamp = -1.f;
+
+	/** Round trip time to the owning client, in seconds */
+	float GetClientRoundTripTime() const;
+
+public:
+	bool HasPendingStateCorrection() const { return bPendingStateCorrection; }
+
+	/** True if the client reported the same stack for the move at Timestamp, so a correction for it can omit the stack */
+	bool DoesClientStackMatch(int32 Slot, float Timestamp) const
+	{
+		return ClientReportedTimestamp == Timestamp && ClientReportedModifiers.IsValidIndex(Slot) &&
+			ClientReportedModifiers[Slot] == ModifierRegistry.Modifiers[Slot]->Modifiers;
+	}
+
+protected:
+	/** Every modifier channel, registered in the constructor */
+	FModifierRegistry ModifierRegistry;
+
+public:
+	const FModifierRegistry& GetModifierRegistry() const { return ModifierRegistry; }
+
+protected:
+	/** Combined params of every active modifier, recomputed by UpdateEffectiveModifierParams() when a level changes */
+	FModifierEffectiveParams EffectiveModifierParams;
+
+public:
+	const FModifierEffectiveParams& GetEffectiveModifierParams() const { return EffectiveModifierParams; }
+
+	/** Combined scalar of every active modifier for a movement property */
+	float GetModifierScalar(EModifierParam Param) const { return EffectiveModifierParams.Movement[Param]; }
+
+	/**
+	 * Recombine the params of every active modifier into EffectiveModifierParams
+	 * Called whenever a modifier level changes, call it yourself if you set a level directly
+	 * Combines every registered channel that declares MovementParams or FallingParams
+	 */
+	virtual void UpdateEffectiveModifierParams();
+
+protected:
+	/** Modifier state of the most recent moves, recorded by the server, see ModifierHistorySize */
+	FModifierHistory ModifierHistory;
+
+public:
+	/** Modifier state of the most recent moves on the server, keyed by server world time, see FModifierHistory */
+	const FModifierHistory& GetModifierHistory() const { return ModifierHistory; }
+
+	/**
+	 * The level of a modifier channel at a past move on the server, e.g. to find if a character was snared when it was hit
+	 * @param ModifierType The channel, e.g. Modifier.Snare
+	 * @param ServerTime Server world time to query, shared by every character -- not a move timestamp, which is on the
+	 *	owning client's clock -- a client reads it with AGameStateBase::GetServerWorldTimeSeconds()
+	 * @param bFound False if the channel isn't registered or ServerTime predates the history
+	 * @return The level tag, or an empty tag if no level was active
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category=Character)
+	FGameplayTag GetModifierLevelAtServerTime(FGameplayTag ModifierType, double ServerTime, bool& bFound) const;
+
+protected:
+	/** Timestamp of the move being simulated, used by GetTimestamp() while it differs from the current one, e.g. replay */
+	float MoveTimestamp = -1.f;
+
+	/** Timestamp timed modifiers were last processed at, used to detect the client timestamp being reset */
+	float LastTimerTimestamp = -1.f;
+
+public:
+	/**
+	 * The timestamp timed modifiers expire against, which matches between client and server for the same move
+	 * @see UProneMovement::GetTimestamp()
+	 */
+	float GetTimestamp() const;
+
+	/**
+	 * Removes timed modifiers that expired by the current move, and adds scheduled modifiers that start on it
+	 * @see FMovementModifier::AddTimedModifier()
+	 * @see ScheduleModifier()
+	 */
+	virtual void ProcessModifierTimers();
+
+protected:
+	/** Client driven wanted stacks to switch to part way through the next move, indexed by registered modifier */
+	TModifierSlotArray<TModifierStack> PendingWantsModifiers;
+
+	/** Point within the next move to switch to PendingWantsModifiers at, see FModifierStatics::QuantizeSubMoveAlpha() */
+	uint8 PendingWantsAlpha = 0;
+	bool bHasPendingWantsChange = false;
+
+	/** Switch to PendingWantsModifiers and evaluate them for the rest of the move */
+	void ApplyWantsChange();
+
+public:
+	/**
+	 * Switch a client driven wanted stack part way through the next move, whose physics is then simulated in two steps
+	 * Used when combining moves whose wanted stacks differ, so the combined move plays out the same as the moves did
+	 * individually, see FSavedMove_Character_Modifier::CombineWith()
+	 */
+	void QueueWantsChange(int32 Slot, const TModifierStack& WantsModifiers, uint8 SubMoveAlpha);
+	void ClearWantsChange() { bHasPendingWantsChange = false; }
+
 	virtual void ProcessModifierMovementState();
 	virtual void UpdateModifierMovementState();
 
+protected:
+	/** Channels whose level changed since DispatchModifierEvents() was last called, indexed by channel */
+	TModifierChannelArray<FModifierPendingEvent> PendingModifierEvents;
+
+public:
+	/**
+	 * Queue the change of a channel's level, dispatched by DispatchModifierEvents()
+	 * A channel can change many times in a tick, e.g. while combining moves or replaying them after a correction
+	 */
+	void QueueModifierEvent(int32 Channel, TModSize PrevLevel);
+
+	/**
+	 * Notify the character of the net change of every channel since the last call, called at the end of TickComponent()
+	 * Channels that changed and changed back, e.g. during replay, don't notify at all
+	 */
+	virtual void DispatchModifierEvents();
+
+	/**
+	 * Force every modifier channel to be re-evaluated on the next update
+	 * Channels are otherwise only evaluated when a wanted stack or their CanXInCurrentState() result changes, so call
+	 * this after changing anything else they depend on, e.g. max modifiers, or levels set directly
+	 */
+	virtual void MarkModifiersDirty();
+
+	/** Evaluate the modifiers for the physics that follows, at the start of a move and where a split move changes stacks */
+	virtual void UpdateModifierStateBeforePhysics();
+
 	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
 	virtual void UpdateCharacterStateAfterMovement(float DeltaSeconds) override;
 	
@@ -307,7 +590,7 @@ public:
 	/* Client Auth Implementation */
 
 	virtual FClientAuthData* ProcessClientAuthData();
-	FClientAuthParams* GetClientAuthParamsForSource(const FGameplayTag& Source) { return ClientAuthParams.Find(Source); }
+	const FClientAuthParams* GetClientAuthParamsForSource(const FGameplayTag& Source) const { return GetModifierConfig()->GetClientAuthParamsForSource(Source); }
 	virtual FClientAuthParams GetClientAuthParams(const FClientAuthData* ClientAuthData);
 
 protected:
@@ -335,6 +618,12 @@ protected:
 public:
 	virtual void ServerMove_PerformMovement(const FCharacterNetworkMoveData& MoveData) override;
 
+protected:
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& NewAccel) override;
+	virtual void ReplicateMoveToServer(float DeltaTime, const FVector& NewAcceleration) override;
+	virtual void PerformMovement(float DeltaTime) override;
+	virtual void StartNewPhysics(float deltaTime, int32 Iterations) override;
+
 protected:
 #if UE_5_08_OR_LATER
 	// UE 5.8 replaced the UPrimitiveComponent* movement-base parameter with FMovementBaseInterfaceData*
@@ -383,6 +672,19 @@ protected:
 
 	virtual bool ClientUpdatePositionAfterServerUpdate() override;
 
+public:
+	virtual void ServerSendMoveResponse(const FClientAdjustment& PendingAdjustment) override;
+	virtual void ClientAckGoodMove_Implementation(float TimeStamp) override;
+
+protected:
+	/**
+	 * Apply the modifier stacks the server acked a move with, without rewinding or replaying the client
+	 * Saved moves that recorded the same stale stacks as the acked move are updated, so they aren't flagged again
+	 * A stack the client changed since the acked move is left as predicted, the server follows up with a full
+	 * correction if it still disagrees, see FModifierPendingCorrection::bStateOnly
+	 */
+	virtual void OnClientStateCorrectionReceived(float TimeStamp, const FModifierMoveResponseDataContainer& MoveResponse);
+
 protected:
 	virtual void TickCharacterPose(float DeltaTime) override;  // ACharacter::GetAnimRootMotionTranslationScale() is non-virtual so we have to duplicate this entire function
 	
@@ -406,17 +708,21 @@ public:
 	virtual ~FSavedMove_Character_Modifier() override
 	{}
 
-	FModifierSavedMove BoostLocal;
-	FModifierSavedMove_WithCorrection BoostCorrection;
-	FModifierSavedMove_ServerInitiated BoostServer;
-	
-	FModifierSavedMove_ServerInitiated SnareServer;
+	/**
+	 * Saved stacks indexed by registered modifier
+	 * WantsModifiers are saved for LocalPredicted and WithCorrection, Modifiers for WithCorrection and ServerInitiated
+	 */
+	TModifierSlotArray<FModifierSavedMove_WithCorrection> Modifiers;
 
-	FModifierSavedMove SlowFallLocal;
+	/** Saved levels indexed by registered channel */
+	TModifierChannelArray<uint8> Levels;
 
-	uint8 BoostLevel = NO_MODIFIER;
-	uint8 SnareLevel = NO_MODIFIER;
-	uint8 SlowFallLevel = NO_MODIFIER;
+	/**
+	 * The client driven wanted stacks changed part way through this combined move, from StartWantsModifiers to
+	 * WantsModifiers at WantsChangeAlpha, see CombineWith()
+	 */
+	bool bHasWantsChange = false;
+	uint8 WantsChangeAlpha = 0;
 	
 	/** Clear saved move properties, so it can be re-used. */
 	virtual void Clear() override;
@@ -436,6 +742,9 @@ public:
 	/** Set the properties describing the final position, etc. of the moved pawn. */
 	virtual void PostUpdate(ACharacter* C, EPostUpdateMode PostUpdateMode) override;
 
+	/** Called before ClientUpdatePosition uses this SavedMove to make a predictive correction. */
+	virtual void PrepMoveFor(ACharacter* C) override;
+
 	/** Returns true if this move is an "important" move that should be sent again if not acked by the server */
 	virtual bool IsImportantMove(const FSavedMovePtr& LastAckedMove) const override;
 };
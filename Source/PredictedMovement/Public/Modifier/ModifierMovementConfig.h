@@ -0,0 +1,94 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ModifierImpl.h"
+#include "ModifierTypes.h"
+#include "Engine/DataAsset.h"
+#include "ModifierMovementConfig.generated.h"
+
+/**
+ * Modifier params and client auth params for UModifierMovement, shared by every component that uses it
+ * Components without a config use the class defaults, so the params are only held once per config rather than once
+ * per character
+ * Levels are baked into immutable tables when the config is created, loaded or edited, components point at them
+ * @see UModifierMovement::GetMutableModifierConfig() to override the params of a single component
+ */
+UCLASS(BlueprintType)
+class PREDICTEDMOVEMENT_API UModifierMovementConfig : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Boost modifies movement properties such as speed and acceleration
+	 * Scaling applied on a per-Boost-level basis
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayTag, FMovementModifierParams> Boost;
+
+	/** Order of the Boost levels, the level index of each tag, if empty the order of Boost is used */
+	UPROPERTY()
+	TArray<FGameplayTag> BoostLevels;
+
+	/**
+	 * Snare modifies movement properties such as speed and acceleration
+	 * Scaling applied on a per-Snare-level basis
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayTag, FMovementModifierParams> Snare;
+
+	/** Order of the Snare levels, the level index of each tag, if empty the order of Snare is used */
+	UPROPERTY()
+	TArray<FGameplayTag> SnareLevels;
+
+	/**
+	 * SlowFall changes falling properties, such as gravity and air control
+	 * Scaling applied on a per-SlowFall-level basis
+	 */
+	UPROPERTY(Category="Character Movement: Modifiers", EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayTag, FFallingModifierParams> SlowFall;
+
+	/** Order of the SlowFall levels, the level index of each tag, if empty the order of SlowFall is used */
+	UPROPERTY()
+	TArray<FGameplayTag> SlowFallLevels;
+
+	/** Client auth parameters mapped to a source gameplay tag */
+	UPROPERTY(Category="Character Movement (Networking)", EditAnywhere, BlueprintReadOnly)
+	TMap<FGameplayTag, FClientAuthParams> ClientAuthParams;
+
+public:
+	/** Boost levels and params baked from Boost and BoostLevels by BakeLevelTables() */
+	TSharedRef<const TModifierLevelTable<FMovementModifierParams>> BoostLevelTable = FModifierStatics::GetEmptyLevelTable<FMovementModifierParams>();
+
+	/** Snare levels and params baked from Snare and SnareLevels by BakeLevelTables() */
+	TSharedRef<const TModifierLevelTable<FMovementModifierParams>> SnareLevelTable = FModifierStatics::GetEmptyLevelTable<FMovementModifierParams>();
+
+	/** SlowFall levels and params baked from SlowFall and SlowFallLevels by BakeLevelTables() */
+	TSharedRef<const TModifierLevelTable<FFallingModifierParams>> SlowFallLevelTable = FModifierStatics::GetEmptyLevelTable<FFallingModifierParams>();
+
+public:
+	UModifierMovementConfig(const FObjectInitializer& ObjectInitializer);
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/**
+	 * Bakes Boost, Snare and SlowFall into flat tables indexed by level, along with their curves
+	 * Tables are never modified once baked, so this makes new ones rather than touching the ones components point at,
+	 * components pick them up when they call UModifierMovement::BakeModifierLevels()
+	 */
+	virtual void BakeLevelTables();
+
+	/** @return The client auth params for a source, or nullptr if there are none */
+	const FClientAuthParams* GetClientAuthParamsForSource(const FGameplayTag& Source) const { return ClientAuthParams.Find(Source); }
+
+	/** @return Heap memory used by the params and levels, not counting the baked tables */
+	SIZE_T GetParamsAllocatedSize() const;
+};
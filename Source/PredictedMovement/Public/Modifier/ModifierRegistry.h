@@ -0,0 +1,285 @@
+// Copyright (c) Jared Taylor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "ModifierImpl.h"
+#include "ModifierTypes.h"
+
+/** Number of registered modifiers (each net type of each channel, e.g. BoostLocal) held inline by the registry and move data */
+#ifndef MODIFIER_REGISTRY_INLINE_SLOTS
+#define MODIFIER_REGISTRY_INLINE_SLOTS 8
+#endif
+
+/** Number of registered channels (e.g. Boost) held inline by the registry and move data */
+#ifndef MODIFIER_REGISTRY_INLINE_CHANNELS
+#define MODIFIER_REGISTRY_INLINE_CHANNELS 4
+#endif
+
+/** Storage indexed by registered modifier */
+template<typename T>
+using TModifierSlotArray = TArray<T, TInlineAllocator<MODIFIER_REGISTRY_INLINE_SLOTS>>;
+
+/** Storage indexed by registered channel */
+template<typename T>
+using TModifierChannelArray = TArray<T, TInlineAllocator<MODIFIER_REGISTRY_INLINE_CHANNELS>>;
+
+/**
+ * Declares a modifier channel, e.g. Boost
+ * Points at the config and level owned by the movement component, so those remain regular properties
+ */
+struct PREDICTEDMOVEMENT_API FModifierChannelDef
+{
+	/** Processes a channel with a level method fixed at compile time, see FModifierStatics::ProcessModifierLevels<Method> */
+	using FProcessLevelsFunc = bool(*)(TModSize& CurrentLevel, const TArray<FGameplayTag>& LevelTags, bool bLimitMaxModifiers,
+		int32 MaxModifiers, TModSize InvalidLevel, TArrayView<FMovementModifier* const> Modifiers, bool bCanActivate);
+
+	/** The modifier type, e.g. Modifier.Boost, passed to AModifierCharacter::NotifyModifierChanged() */
+	FGameplayTag ModifierType;
+
+	/** The current level of the channel, e.g. UModifierMovement::BoostLevel */
+	TModSize* Level = nullptr;
+
+	/** Level tags, indexed by level */
+	const TArray<FGameplayTag>* LevelTags = nullptr;
+
+	/** The method used to calculate levels, can be changed at runtime, e.g. from Blueprint, see ProcessLevels */
+	const EModifierLevelMethod* LevelMethod = nullptr;
+
+	/** Whether to limit the number of modifiers, and the limit, shared by every modifier of the channel */
+	const bool* bLimitMaxModifiers = nullptr;
+	const int32* MaxModifiers = nullptr;
+
+	/** Baked movement params indexed by level, if the channel modifies movement, e.g. Boost */
+	const TArray<FMovementModifierParams>* MovementParams = nullptr;
+
+	/** Baked falling params indexed by level, if the channel modifies falling, e.g. SlowFall */
+	const TArray<FFallingModifierParams>* FallingParams = nullptr;
+
+	/** Whether the channel can be applied in the current state, e.g. CanBoostInCurrentState() */
+	TFunction<bool()> CanActivate;
+
+	/**
+	 * Number of levels and max modifiers the channel's stacks are serialized to, see FModifierRegistry::InitNetLimits()
+	 * MaxModifiers and the levels can be changed at runtime on either side, so they can't size the bits the other side reads
+	 */
+	int32 NetNumLevels = 0;
+	int32 NetMaxModifiers = 0;
+
+	/**
+	 * The level method fixed at compile time, e.g. &FModifierStatics::ProcessModifierLevels<EModifierLevelMethod::Max>
+	 * Bound to the policy of LevelMethod by FModifierRegistry, and bound again when LevelMethod changes
+	 * Channels without a LevelMethod set it themselves, as their method never changes
+	 */
+	FProcessLevelsFunc ProcessLevels = nullptr;
+
+	/** The LevelMethod that ProcessLevels was bound for */
+	EModifierLevelMethod BoundLevelMethod = EModifierLevelMethod::Max;
+};
+
+/**
+ * Registry of the modifier channels of a movement component, stored as struct-of-arrays
+ * Every channel is processed, saved, serialized and corrected by the same loops, so adding a modifier only requires
+ * declaring its channel and modifiers, see UModifierMovement::UModifierMovement()
+ *
+ * Modifiers are grouped by channel in priority order (LocalPredicted -> WithCorrection -> ServerInitiated), which is
+ * also the order they consume the channel's MaxModifiers and the order they are serialized in
+ * Client and server must register the same channels in the same order
+ */
+struct PREDICTEDMOVEMENT_API FModifierRegistry
+{
+	/* Channels, indexed by channel */
+
+	TModifierChannelArray<FModifierChannelDef> Channels;
+	TModifierChannelArray<FModifierChannelDirtyState> DirtyStates;
+	TModifierChannelArray<int32> FirstModifiers;
+	TModifierChannelArray<int32> NumChannelModifiers;
+
+	/* Modifiers, indexed by slot */
+
+	TModifierSlotArray<FMovementModifier*> Modifiers;
+	TModifierSlotArray<EModifierNetType> NetTypes;
+	TModifierSlotArray<int32> ModifierChannels;
+
+	/** Reported when serialization fails */
+	TModifierSlotArray<FString> Names;
+
+	/**
+	 * Register a channel, its modifiers must be added immediately after with AddModifier()
+	 * @return The channel index
+	 */
+	int32 AddChannel(FModifierChannelDef&& Channel);
+
+	/**
+	 * Register a modifier of the most recently added channel
+	 * @return The slot index
+	 */
+	int32 AddModifier(int32 Channel, FMovementModifier& Modifier, EModifierNetType NetType, const FString& Name);
+
+	int32 NumChannels() const { return Channels.Num(); }
+	int32 NumModifiers() const { return Modifiers.Num(); }
+
+	TArrayView<FMovementModifier* const> GetChannelModifiers(int32 Channel) const
+	{
+		return MakeArrayView(Modifiers.GetData() + FirstModifiers[Channel], NumChannelModifiers[Channel]);
+	}
+
+	FGameplayTag GetLevelTag(int32 Channel) const
+	{
+		return GetLevelTag(Channel, *Channels[Channel].Level);
+	}
+
+	FGameplayTag GetLevelTag(int32 Channel, TModSize Level) const
+	{
+		const FModifierChannelDef& Def = Channels[Channel];
+		return Def.LevelTags->IsValidIndex(Level) ? (*Def.LevelTags)[Level] : FGameplayTag::EmptyTag;
+	}
+
+	int32 FindChannel(const FGameplayTag& ModifierType) const
+	{
+		return Channels.IndexOfByPredicate([&ModifierType](const FModifierChannelDef& Def) { return Def.ModifierType == ModifierType; });
+	}
+
+	/** True if the modifier's wanted stack is driven by the client, i.e. it is sent to the server and restored after replay */
+	bool HasClientWants(int32 Slot) const { return NetTypes[Slot] != EModifierNetType::ServerInitiated; }
+
+	/** True if the server verifies the modifier's stack and corrects the client when it differs */
+	bool HasServerCorrection(int32 Slot) const { return NetTypes[Slot] != EModifierNetType::LocalPredicted; }
+
+	/** True if the modifier's timers are owned by the server and sent with its corrections */
+	bool HasServerTimers(int32 Slot) const { return NetTypes[Slot] == EModifierNetType::ServerInitiated; }
+
+	/** Serialize a stack of the modifier bit packed to the levels and max modifiers its channel had when registered */
+	bool NetSerializeStack(int32 Slot, TModifierStack& Stack, FArchive& Ar) const;
+
+	/**
+	 * Capture the number of levels and max modifiers every channel is serialized to, once, when the component registers
+	 * Later calls do nothing, so a runtime change made on one side can't change the bit widths the other side reads
+	 * Also caps each modifier's wanted stack to its channel's max, see FMovementModifier::MaxWantsModifiers
+	 */
+	void InitNetLimits();
+
+	bool bNetLimitsInitialized = false;
+
+	void MarkDirty()
+	{
+		for (FModifierChannelDirtyState& DirtyState : DirtyStates)
+		{
+			DirtyState.MarkDirty();
+		}
+	}
+
+	/**
+	 * Processes the modifiers of a channel, see FModifierStatics::ProcessModifiers()
+	 * @return True if the channel changed
+	 */
+	bool ProcessChannel(int32 Channel);
+
+	/** Binds the channel's ProcessLevels to the compile-time policy of its current LevelMethod, if it has one */
+	static void BindLevelPolicy(FModifierChannelDef& Channel);
+
+	/**
+	 * Serialize client move data for every modifier, only the stacks required by its net type are sent
+	 * Each stack costs a single bit when it is empty or matches Baseline
+	 * @param bHasWantsChange If the wanted stacks changed part way through the move, which also sends their start stacks
+	 * @param Baseline Move data already serialized in the same packet, e.g. the new move when serializing the old move
+	 */
+	bool NetSerializeMoveData(TModifierSlotArray<FModifierMoveData_WithCorrection>& MoveData, FArchive& Ar,
+		bool bHasWantsChange, const TModifierSlotArray<FModifierMoveData_WithCorrection>* Baseline = nullptr) const;
+
+	/**
+	 * Serialize server corrected stacks for every WithCorrection and ServerInitiated modifier, and ServerInitiated timers
+	 * Each stack is preceded by a bit of the dirty mask, stacks that match the client's are omitted and left for the
+	 * caller to restore, see FModifierMoveResponse::bMatchesClient
+	 */
+	bool NetSerializeMoveResponse(TModifierSlotArray<FModifierMoveResponse>& Response, FArchive& Ar) const;
+
+	/**
+	 * Serialize pending schedules for every ServerInitiated modifier, sent with every move response
+	 * Costs a single bit when nothing is scheduled
+	 */
+	bool NetSerializeSchedules(TModifierSlotArray<FModifierMoveResponse>& Response, FArchive& Ar) const;
+
+	/** Combine the params of the active level of every channel */
+	void CombineEffectiveParams(FModifierEffectiveParams& Params, const FVector& Velocity) const;
+};
+
+/** The level of every channel and their combined params at a move, see FModifierHistory */
+struct PREDICTEDMOVEMENT_API FModifierHistoryEntry
+{
+	/** Server world time the move was performed at, see FModifierHistory */
+	double ServerTime = 0.0;
+
+	/** Levels indexed by registered channel */
+	TModifierChannelArray<TModSize> Levels;
+
+	/*
+	 * Combined params, copied by value -- FModifierEffectiveParams::Falling points into a baked table that a later bake
+	 * can replace, the falling params of a level can be found from Levels instead
+	 */
+
+	/** Product of the active movement modifier scalars, indexed by EModifierParam */
+	FModifierParamVector Movement;
+
+	/** Product of the MaxWalkSpeed scalars of the active modifiers that affect root motion */
+	float RootMotionTranslationScalar = 1.f;
+	bool bAffectsRootMotion = false;
+
+	/** Gravity scalar of the active falling modifier, resolved with the velocity the move ended with */
+	float GravityScalar = 1.f;
+};
+
+/**
+ * Fixed size ring of modifier state, recorded once per move on the server for lag compensated queries, e.g. whether
+ * the target of a hit was snared when the shooter fired
+ * Storage is allocated once by Init(), recording overwrites the oldest entry and never allocates
+ *
+ * Keyed by server world time, UWorld::GetTimeSeconds() on the server, which every character shares -- move timestamps
+ * are on each owning client's own clock and AI has none, so they can't be compared across characters
+ * A client reports a time on this clock with AGameStateBase::GetServerWorldTimeSeconds(), e.g. with a fire request
+ * Time only moves forward, so lookups are a binary search
+ */
+struct PREDICTEDMOVEMENT_API FModifierHistory
+{
+	/** Allocates storage for Capacity entries, discarding the history */
+	void Init(int32 Capacity);
+
+	/** Discards the history, keeping the storage */
+	void Reset()
+	{
+		Head = 0;
+		NumEntries = 0;
+	}
+
+	/**
+	 * Records the state of every channel at ServerTime
+	 * Moves performed in the same frame share a time, the last one recorded is kept
+	 * A time earlier than the newest, e.g. after a seamless travel, discards the history to keep it sorted
+	 */
+	void Record(double ServerTime, const FModifierRegistry& Registry, const FModifierEffectiveParams& Params,
+		const FVector& Velocity);
+
+	/**
+	 * Find the state in effect at ServerTime, i.e. the newest entry recorded at or before it
+	 * @return The entry, or nullptr if ServerTime predates the history
+	 */
+	const FModifierHistoryEntry* Find(double ServerTime) const;
+
+	int32 Capacity() const { return Entries.Num(); }
+	int32 Num() const { return NumEntries; }
+
+	/** @return Entry by age, 0 is the oldest */
+	const FModifierHistoryEntry& operator[](int32 Index) const
+	{
+		check(Index >= 0 && Index < NumEntries);
+		return Entries[(Head - NumEntries + Index + Entries.Num()) % Entries.Num()];
+	}
+
+private:
+	TArray<FModifierHistoryEntry> Entries;
+
+	/** Index the next entry is written to */
+	int32 Head = 0;
+	int32 NumEntries = 0;
+};
@@ -51,6 +51,131 @@ enum class EModifierFallZ : uint8
 	Rising				UMETA(ToolTip="Remove Velocity.Z when modifier starts, but only if the character is rising (Velocity.Z > 0)"),
 };
 
+/** Number of samples a curve is baked into, see FModifierCurveTable */
+#ifndef MODIFIER_CURVE_TABLE_RESOLUTION
+#define MODIFIER_CURVE_TABLE_RESOLUTION 64
+#endif
+
+/**
+ * A curve baked into a fixed-resolution lookup table, sampled with linear interpolation
+ * Evaluating a curve searches its keys on every query, which adds up when a param is queried several times per physics
+ * iteration; the table makes it a couple of loads and a lerp, close to the cost of a constant scalar
+ * Times outside the curve's key range are clamped, matching the default constant extrapolation
+ */
+struct PREDICTEDMOVEMENT_API FModifierCurveTable
+{
+	/** Time of the first sample */
+	float MinTime = 0.f;
+
+	/** Samples per unit of time */
+	float SamplesPerTime = 0.f;
+
+	/** Evenly spaced samples from the first to the last key */
+	TArray<float> Samples;
+
+	bool IsBaked() const { return Samples.Num() > 0; }
+
+	void Reset()
+	{
+		MinTime = 0.f;
+		SamplesPerTime = 0.f;
+		Samples.Reset();
+	}
+
+	void Bake(const UCurveFloat* Curve, int32 Resolution = MODIFIER_CURVE_TABLE_RESOLUTION)
+	{
+		Reset();
+		if (!Curve)
+		{
+			return;
+		}
+
+		float MaxTime = 0.f;
+		Curve->GetTimeRange(MinTime, MaxTime);
+
+		// A flat or single-key curve only needs one sample
+		const float Range = MaxTime - MinTime;
+		const int32 NumSamples = Range > UE_KINDA_SMALL_NUMBER ? FMath::Max(Resolution, 2) : 1;
+		SamplesPerTime = NumSamples > 1 ? (NumSamples - 1) / Range : 0.f;
+
+		Samples.SetNumUninitialized(NumSamples);
+		for (int32 Index = 0; Index < NumSamples; Index++)
+		{
+			const float Time = NumSamples > 1 ? MinTime + Index / SamplesPerTime : MinTime;
+			Samples[Index] = Curve->GetFloatValue(Time);
+		}
+	}
+
+	float Evaluate(float Time) const
+	{
+		checkSlow(IsBaked());
+
+		const float Alpha = (Time - MinTime) * SamplesPerTime;
+		const int32 LastIndex = Samples.Num() - 1;
+		if (Alpha <= 0.f || LastIndex == 0)
+		{
+			return Samples[0];
+		}
+		if (Alpha >= LastIndex)
+		{
+			return Samples[LastIndex];
+		}
+
+		const int32 Index = FMath::FloorToInt32(Alpha);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], Alpha - Index);
+	}
+};
+
+/** Movement properties that a modifier can scale, indexes FModifierParamVector */
+enum class EModifierParam : uint8
+{
+	MaxWalkSpeed,
+	MaxAcceleration,
+	BrakingDeceleration,
+	GroundFriction,
+	BrakingFriction,
+	JumpZVelocity,
+	RotationRate,
+	AirControl,
+	MaxWalkSpeedCrouched,
+	MaxSwimSpeed,
+	MaxFlySpeed,
+	Num,
+};
+
+/**
+ * One scalar per EModifierParam, padded to whole vector registers
+ * Modifiers combine by multiplying their vectors, so every property is scaled in a single pass regardless of count
+ */
+struct alignas(16) FModifierParamVector
+{
+	static constexpr int32 NumRegisters = (static_cast<int32>(EModifierParam::Num) + 3) / 4;
+	static constexpr int32 NumValues = NumRegisters * 4;
+
+	float Values[NumValues];
+
+	FModifierParamVector()
+	{
+		for (float& Value : Values)
+		{
+			Value = 1.f;
+		}
+	}
+
+	float operator[](EModifierParam Param) const { return Values[static_cast<int32>(Param)]; }
+	float& operator[](EModifierParam Param) { return Values[static_cast<int32>(Param)]; }
+
+	FModifierParamVector& operator*=(const FModifierParamVector& Other)
+	{
+		for (int32 Register = 0; Register < NumRegisters; Register++)
+		{
+			float* Dest = &Values[Register * 4];
+			VectorStoreAligned(VectorMultiply(VectorLoadAligned(Dest), VectorLoadAligned(&Other.Values[Register * 4])), Dest);
+		}
+		return *this;
+	}
+};
+
 /**
  * Parameters for a modifier that affects character movement
  */
@@ -67,6 +192,12 @@ struct PREDICTEDMOVEMENT_API FMovementModifierParams
 		, GroundFriction(InGroundFriction)
 		, BrakingFriction(InBrakingFriction)
 		, bAffectsRootMotion(bInAffectsRootMotion)
+		, JumpZVelocity(1.f)
+		, RotationRate(1.f)
+		, AirControl(1.f)
+		, MaxWalkSpeedCrouched(1.f)
+		, MaxSwimSpeed(1.f)
+		, MaxFlySpeed(1.f)
 	{}
 	
 	/** The maximum ground speed when walking. Also determines maximum lateral speed when falling. */
@@ -108,6 +239,48 @@ struct PREDICTEDMOVEMENT_API FMovementModifierParams
 	/** If true, this modifier's MaxWalkSpeed scalar affects root motion translation */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
 	bool bAffectsRootMotion;
+
+	/** Initial velocity (instantaneous vertical acceleration) when jumping. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float JumpZVelocity;
+
+	/** Change in rotation per second, used when UseControllerDesiredRotation or OrientRotationToMovement are true. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float RotationRate;
+
+	/** When falling, amount of lateral movement control available to the character. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float AirControl;
+
+	/** Scales MaxWalkSpeed further while crouched, so the crouched speed is MaxWalkSpeedCrouched * MaxWalkSpeed * this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float MaxWalkSpeedCrouched;
+
+	/** Scales MaxWalkSpeed further while swimming, so the swim speed is MaxSwimSpeed * MaxWalkSpeed * this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float MaxSwimSpeed;
+
+	/** Scales MaxWalkSpeed further while flying, so the fly speed is MaxFlySpeed * MaxWalkSpeed * this */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, AdvancedDisplay, meta=(ClampMin="0", UIMin="0", ForceUnits="x"))
+	float MaxFlySpeed;
+
+	/** The scalars as a vector, for combining with other modifiers */
+	FModifierParamVector ToVector() const
+	{
+		FModifierParamVector Vector;
+		Vector[EModifierParam::MaxWalkSpeed] = MaxWalkSpeed;
+		Vector[EModifierParam::MaxAcceleration] = MaxAcceleration;
+		Vector[EModifierParam::BrakingDeceleration] = BrakingDeceleration;
+		Vector[EModifierParam::GroundFriction] = GroundFriction;
+		Vector[EModifierParam::BrakingFriction] = BrakingFriction;
+		Vector[EModifierParam::JumpZVelocity] = JumpZVelocity;
+		Vector[EModifierParam::RotationRate] = RotationRate;
+		Vector[EModifierParam::AirControl] = AirControl;
+		Vector[EModifierParam::MaxWalkSpeedCrouched] = MaxWalkSpeedCrouched;
+		Vector[EModifierParam::MaxSwimSpeed] = MaxSwimSpeed;
+		Vector[EModifierParam::MaxFlySpeed] = MaxFlySpeed;
+		return Vector;
+	}
 };
 
 /**
@@ -162,9 +335,23 @@ struct PREDICTEDMOVEMENT_API FFallingModifierParams
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Modifier, meta=(EditCondition="bOverrideAirControl", EditConditionHides))
 	float AirControlOverride;
 
+	/** GravityScalarFallVelocityCurve baked by BakeCurves(), used instead of evaluating the curve when available */
+	FModifierCurveTable GravityScalarFallVelocityTable;
+
+	/** Bake curves into lookup tables, called on the flat level tables by UModifierMovement::BakeModifierLevels() */
+	void BakeCurves()
+	{
+		GravityScalarFallVelocityTable.Reset();
+		if (bGravityScalarFromVelocityZ)
+		{
+			GravityScalarFallVelocityTable.Bake(GravityScalarFallVelocityCurve);
+		}
+	}
+
 	/**
 	 * Get the gravity scalar based on the current velocity.
-	 * If bGravityScalarFromVelocityZ is true, uses GravityScalarFallVelocityCurve to determine the scalar based on Velocity.Z.
+	 * If bGravityScalarFromVelocityZ is true, uses GravityScalarFallVelocityCurve to determine the scalar based on Velocity.Z,
+	 * sampled from GravityScalarFallVelocityTable if it was baked.
 	 * Otherwise, returns GravityScalar.
 	 */
 	float GetGravityScalar(const FVector& Velocity) const
@@ -173,7 +360,12 @@ struct PREDICTEDMOVEMENT_API FFallingModifierParams
 		{
 			return 1.f;
 		}
-		return bGravityScalarFromVelocityZ ? GravityScalarFallVelocityCurve->GetFloatValue(Velocity.Z) : GravityScalar;
+		if (!bGravityScalarFromVelocityZ)
+		{
+			return GravityScalar;
+		}
+		return GravityScalarFallVelocityTable.IsBaked() ? GravityScalarFallVelocityTable.Evaluate(Velocity.Z) :
+			GravityScalarFallVelocityCurve->GetFloatValue(Velocity.Z);
 	}
 
 	/**
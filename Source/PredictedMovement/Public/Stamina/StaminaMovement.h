@@ -16,6 +16,9 @@ struct PREDICTEDMOVEMENT_API FStaminaMoveResponseDataContainer : FCharacterMoveR
 
 	float Stamina;
 	bool bStaminaDrained;
+
+	/** The ack carries the stamina state, as only it mismatched, see UStaminaMovement::bUseStateOnlyCorrections */
+	bool bHasStateCorrection = false;
 };
 
 struct PREDICTEDMOVEMENT_API FStaminaNetworkMoveData : FCharacterNetworkMoveData
@@ -88,6 +91,13 @@ public:
 	/** Maximum stamina difference that is allowed between client and server before a correction occurs. */
 	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly, meta=(ClampMin="0.0", UIMin="0.0"))
 	float NetworkStaminaCorrectionThreshold;
+
+	/**
+	 * If true, a move whose position agrees with the server but whose stamina doesn't is acked with the server's stamina
+	 * instead of being corrected, so the client applies it without rewinding and replaying its moves
+	 */
+	UPROPERTY(Category="Character Movement (Networking)", EditDefaultsOnly)
+	bool bUseStateOnlyCorrections = true;
 	
 public:
 	UStaminaMovement(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
@@ -104,10 +114,14 @@ private:
 	UPROPERTY()
 	bool bStaminaDrained;
 
+	/** Set by ServerCheckClientError() when the last move only mismatched stamina, sent with the next ack */
+	bool bPendingStateCorrection = false;
+
 public:
 	float GetStamina() const { return Stamina; }
 	float GetMaxStamina() const { return MaxStamina; }
 	bool IsStaminaDrained() const { return bStaminaDrained; }
+	bool HasPendingStateCorrection() const { return bPendingStateCorrection; }
 
 	void SetStamina(float NewStamina);
 
@@ -165,6 +179,18 @@ public:
 		UPrimitiveComponent* ClientMovementBase, FName ClientBaseBoneName, uint8 ClientMovementMode) override;
 #endif
 
+	virtual void ServerSendMoveResponse(const FClientAdjustment& PendingAdjustment) override;
+	virtual void ClientAckGoodMove_Implementation(float TimeStamp) override;
+
+protected:
+	/**
+	 * Apply the stamina the server acked a move with, without rewinding or replaying the client
+	 * Saved moves made since the acked move are offset by the same amount, so they aren't flagged again
+	 * The drained state is only replaced up to the first drain or recovery the client predicted after the acked move
+	 */
+	virtual void OnClientStateCorrectionReceived(float TimeStamp, float ServerStamina, bool bServerStaminaDrained);
+
+public:
 	/** Get prediction data for a client game. Should not be used if not running as a client. Allocates the data on demand and can be overridden to allocate a custom override if desired. Result must be a FNetworkPredictionData_Client_Character. */
 	virtual class FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 };